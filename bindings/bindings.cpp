@@ -1,13 +1,25 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/functional.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <utility>
 #include <vector>
 #include <pybind11/numpy.h>
 #include "../include/Network.hpp"
 #include "../include/Population.hpp"
 #include "../include/GymnasiumWrapper.hpp"
+#include "../include/GenomeView.hpp"
+#include "../include/DecisionBuffer.hpp"
+#include "../include/AsyncEvaluation.hpp"
+#include "../include/Autotuner.hpp"
+#include "../include/PopulationView.hpp"
+#include "../include/Surrogate.hpp"
+#include "../include/Sweep.hpp"
 #include <pybind11/stl_bind.h>
 
 namespace py = pybind11;
@@ -46,7 +58,166 @@ static void force_gc_collect() {
     py::module_::import("gc").attr("collect")();
 }
 
+// Free-threading (PEP 703): every Population carries its own mutex, and each
+// binding that reads or modifies a population holds it for the duration of the
+// call, so Python threads may share a Population (calls are serialised) and
+// independent Populations run fully in parallel. Each Population owns its random
+// generator, so no RNG state is shared between populations. The lock is always
+// acquired without holding the GIL / an attached thread state; otherwise a
+// thread holding the lock while calling back into Python (gymnasium) could
+// deadlock with a thread waiting for the lock.
+// The thread_local conversion buffers are per OS thread and are only used
+// before the C++ call returns, so they are safe without a GIL as well.
+// Not guarded: direct member access (the vector returned by pop.individuals,
+// Network and StreamWindow objects); these must not be modified while another
+// thread uses the owner.
+// A population with an uncommitted evaluateAsync() rejects all other calls
+// until EvaluationHandle.wait() (the waiting would otherwise block silently),
+// and so does a population whose individuals are moved into an active subset
+// view (PopulationView) until the view is released.
+// The flags are atomic and checked before the mutex is taken (lockIdlePopulation()),
+// so a conflicting call raises at once instead of waiting for the evaluation.
+static std::unique_lock<std::mutex> lock_idle_population(const Population &self) {
+    return lockIdlePopulation(self);
+}
+
+static std::unique_lock<std::mutex> lock_population(const Population &self) {
+    py::gil_scoped_release release;
+    return lock_idle_population(self);
+}
+
+// Helper: bind a Population member function so that it runs under the lock of
+// the population (used together with py::call_guard<py::gil_scoped_release>).
+template <typename Return, typename... Args>
+static auto locked(Return (Population::*method)(Args...)) {
+    return [method](Population &self, Args... args) -> Return {
+        auto lock = lock_idle_population(self);
+        return (self.*method)(std::forward<Args>(args)...);
+    };
+}
+
+// Helper: gather one value per individual into a freshly allocated 1D numpy
+// array. The networks are stored as an array of structs, so a true view over
+// the population is not possible; instead every accessor costs one allocation
+// and a single pass over the individuals without creating Python objects.
+template <typename T, typename Func>
+static py::array_t<T> population_column(const Population &self, Func &&value) {
+    auto lock = lock_population(self);
+    py::array_t<T> out(static_cast<py::ssize_t>(self.individuals.size()));
+    auto view = out.template mutable_unchecked<1>();
+    for (size_t i = 0; i < self.individuals.size(); ++i) {
+        view(i) = static_cast<T>(value(self.individuals[i]));
+    }
+    return out;
+}
+
+// Helper: expose a vector of a GenomeView as a writable numpy array over its
+// memory. The owner (the Python GenomeView) is set as base object and thus
+// outlives the array; the vectors of a view are never resized after creation.
+template <typename T>
+static py::array_t<T> genome_array(py::object owner, std::vector<T> &values) {
+    return py::array_t<T>({static_cast<py::ssize_t>(values.size())}, {static_cast<py::ssize_t>(sizeof(T))},
+                          values.data(), owner);
+}
+
+// Helper: copy a 1D numpy array into a vector (used when building a GenomeView).
+template <typename T>
+static std::vector<T> vector_from_numpy(py::array_t<T, py::array::c_style | py::array::forcecast> a) {
+    py::buffer_info buf = a.request();
+    if (buf.ndim != 1)
+        throw std::runtime_error("genome arrays must be 1D");
+    T* ptr = static_cast<T*>(buf.ptr);
+    return std::vector<T>(ptr, ptr + buf.shape[0]);
+}
+
+// Helper: early termination bound of gymnasium()/gymnasiumMultiSeed(); both
+// values must be given to activate it.
+static EpisodeBound make_episode_bound(std::optional<double> threshold, std::optional<double> maxStepReward) {
+    if (threshold.has_value() != maxStepReward.has_value())
+        throw std::runtime_error("threshold and maxStepReward must be given together");
+    EpisodeBound bound;
+    if (threshold) {
+        bound.threshold = *threshold;
+        bound.maxStepReward = *maxStepReward;
+    }
+    return bound;
+}
+
+// Declare the module free-threading compatible (pybind11 >= 2.13)
+#if PYBIND11_VERSION_HEX >= 0x020D0000
+PYBIND11_MODULE(_core, m, py::mod_gil_not_used()) {
+#else
 PYBIND11_MODULE(_core, m) {
+#endif
+
+    // Data – only the parts needed to evaluate on virtual (derived) features
+    py::class_<Data>(m, "Data")
+    .def(py::init<>())
+    .def("setX",
+        [](Data &self, py::array_t<float, py::array::c_style | py::array::forcecast> X) {
+            fill_vec2d_from_numpy(X, self.X);
+            self.minX.clear();
+            self.maxX.clear();
+        },
+        py::arg("X"))
+    .def("addLagFeature", &Data::addLagFeature, py::arg("column"), py::arg("k"))
+    .def("addDiffFeature", &Data::addDiffFeature, py::arg("column"), py::arg("k"))
+    .def("addRollingMeanFeature", &Data::addRollingMeanFeature, py::arg("column"), py::arg("w"))
+    .def("addRollingStdFeature", &Data::addRollingStdFeature, py::arg("column"), py::arg("w"))
+    .def("addRatioFeature", &Data::addRatioFeature, py::arg("numerator"), py::arg("denominator"))
+    .def("nFeatures", &Data::nFeatures)
+    .def("minMaxFeatures",
+        [](Data &self) {
+            self.minX.clear();
+            self.maxX.clear();
+            if (self.X.empty())
+                throw std::runtime_error("X must be set before minMaxFeatures()");
+            self.minMaxFeatures(self.X);
+            self.minMaxDerivedFeatures();
+        })
+    .def_readonly("minX", &Data::minX)
+    .def_readonly("maxX", &Data::maxX);
+
+    // Native fitness kernels (compiled in or loaded from shared-library plugins)
+    m.def("loadFitnessPlugin", &loadFitnessPlugin, py::arg("path"));
+    m.def("fitnessKernels", []() { return FitnessRegistry::instance().names(); });
+
+    // Fold index sets for cross-validation
+    py::class_<Fold>(m, "Fold")
+    .def(py::init<>())
+    .def(py::init([](std::vector<size_t> train, std::vector<size_t> test) {
+            return Fold{train, test};
+        }),
+        py::arg("train"), py::arg("test"))
+    .def_readwrite("train", &Fold::train)
+    .def_readwrite("test", &Fold::test);
+
+    m.def("kFoldSplits", &kFoldSplits, py::arg("nRows"), py::arg("k"));
+    m.def("walkForwardSplits", &walkForwardSplits,
+          py::arg("nRows"), py::arg("nFolds"), py::arg("testSize"),
+          py::arg("window")="expanding", py::arg("trainSize")=0);
+
+    // Sliding window for incremental fitness on streaming data
+    py::class_<StreamWindow>(m, "StreamWindow")
+    .def(py::init<size_t>(), py::arg("capacity"))
+    .def("append",
+        [](StreamWindow &self,
+           py::array_t<float, py::array::c_style | py::array::forcecast> X,
+           py::array_t<int, py::array::c_style | py::array::forcecast> y) {
+            std::vector<std::vector<float>> vec2d;
+            fill_vec2d_from_numpy(X, vec2d);
+            py::buffer_info ybuf = y.request();
+            if (ybuf.ndim != 1)
+                throw std::runtime_error("y must be a 1D array");
+            int* yptr = static_cast<int*>(ybuf.ptr);
+            std::vector<int> y_vec(yptr, yptr + ybuf.shape[0]);
+            self.append(vec2d, y_vec);
+        },
+        py::arg("X"), py::arg("y"))
+    .def_property_readonly("firstRow", &StreamWindow::firstRow)
+    .def_property_readonly("endRow", &StreamWindow::endRow)
+    .def_property_readonly("capacity", &StreamWindow::maxSize)
+    .def("__len__", &StreamWindow::size);
 
     // Node
     py::class_<Node>(m, "Node")
@@ -101,6 +272,324 @@ PYBIND11_MODULE(_core, m) {
     ));
 
     // Network
+    // Bit-packed decisions with explicit invalid rows
+    py::class_<DecisionBuffer>(m, "DecisionBuffer")
+    .def("__len__", &DecisionBuffer::size)
+    .def_property_readonly("bitsPerDecision", &DecisionBuffer::bitsPerDecision)
+    .def_property_readonly("nbytes", &DecisionBuffer::bytes)
+    .def_property_readonly("invalidRows", [](const DecisionBuffer &self) {
+        const auto &rows = self.invalidRows();
+        py::array_t<uint64_t> out(static_cast<py::ssize_t>(rows.size()));
+        std::copy(rows.begin(), rows.end(), out.mutable_data());
+        return out;
+    })
+    .def("toArray", [](const DecisionBuffer &self) -> py::object {
+        // unpacked into the narrowest signed dtype; invalid rows are -1
+        auto unpack = [&](auto tag) {
+            using T = decltype(tag);
+            py::array_t<T> out(static_cast<py::ssize_t>(self.size()));
+            T* ptr = out.mutable_data();
+            for (size_t i = 0; i < self.size(); ++i)
+                ptr[i] = static_cast<T>(self[i]);
+            for (size_t row : self.invalidRows())
+                ptr[row] = -1;
+            return py::object(out);
+        };
+        if (self.bitsPerDecision() < 8)
+            return unpack(int8_t{});
+        if (self.bitsPerDecision() < 16)
+            return unpack(int16_t{});
+        if (self.bitsPerDecision() < 32)
+            return unpack(int32_t{});
+        return unpack(int64_t{});
+    });
+
+    // Ring buffer of episode returns of one individual (Network.seedHistory)
+    py::class_<SeedHistory>(m, "SeedHistory")
+    .def(py::init<size_t>(), py::arg("capacity")=0)
+    .def("__len__", &SeedHistory::size)
+    .def_property_readonly("capacity", &SeedHistory::capacity)
+    .def("setCapacity", &SeedHistory::setCapacity, py::arg("capacity"))
+    .def("push", &SeedHistory::push, py::arg("value"))
+    .def("clear", &SeedHistory::clear)
+    .def("toList", &SeedHistory::toVector)
+    .def("aggregate", [](const SeedHistory &self, const std::string &aggregation, float param) {
+        checkSeedAggregation(aggregation, param);
+        return self.aggregate(aggregation, param);
+    }, py::arg("aggregation")="mean", py::arg("param")=0.5f);
+
+    // Anchor and rolling evaluation seeds (Population.seedPool)
+    py::class_<SeedPool>(m, "SeedPool")
+    .def(py::init<>())
+    .def_readwrite("anchors", &SeedPool::anchors)
+    .def_readwrite("rolling", &SeedPool::rolling)
+    .def_readwrite("maxSeed", &SeedPool::maxSeed)
+    .def("seeds", &SeedPool::seeds);
+
+    // Background evaluation started by Population.evaluateAsync(); awaitable
+    // from asyncio via fracnetics.utilsAsync
+    py::class_<EvaluationHandle>(m, "EvaluationHandle")
+    .def("done", &EvaluationHandle::done)
+    .def("wait", &EvaluationHandle::wait, py::call_guard<py::gil_scoped_release>());
+
+    // Individuals of a population moved into a sub-population without copies
+    // (Population.subset()); use as a context manager to move them back.
+    py::class_<PopulationView>(m, "PopulationView")
+    .def_property_readonly("population", &PopulationView::population,
+        py::return_value_policy::reference_internal)
+    .def_property_readonly("parentIndices", &PopulationView::parentIndices)
+    .def_property_readonly("active", &PopulationView::active)
+    .def("release", &PopulationView::release, py::call_guard<py::gil_scoped_release>())
+    .def("__enter__", &PopulationView::population, py::return_value_policy::reference_internal)
+    .def("__exit__", [](PopulationView &self, py::args) {
+        py::gil_scoped_release release;
+        self.release();
+    });
+
+    // Hyperparameter sweeps with successive halving (fracnetics.sweep)
+    py::class_<SweepConfig>(m, "SweepConfig")
+    .def(py::init<>())
+    .def_readwrite("name", &SweepConfig::name)
+    .def_readwrite("seed", &SweepConfig::seed)
+    .def_readwrite("ni", &SweepConfig::ni)
+    .def_readwrite("jn", &SweepConfig::jn)
+    .def_readwrite("jnf", &SweepConfig::jnf)
+    .def_readwrite("pn", &SweepConfig::pn)
+    .def_readwrite("pnf", &SweepConfig::pnf)
+    .def_readwrite("fractalJudgment", &SweepConfig::fractalJudgment)
+    .def_readwrite("tournamentSize", &SweepConfig::tournamentSize)
+    .def_readwrite("nElite", &SweepConfig::nElite)
+    .def_readwrite("probCrossover", &SweepConfig::probCrossover)
+    .def_readwrite("crossoverType", &SweepConfig::crossoverType)
+    .def_readwrite("probEdgeInner", &SweepConfig::probEdgeInner)
+    .def_readwrite("probEdgeStart", &SweepConfig::probEdgeStart)
+    .def_readwrite("probBoundary", &SweepConfig::probBoundary)
+    .def_readwrite("sigmaBoundary", &SweepConfig::sigmaBoundary)
+    .def_readwrite("addDelNodes", &SweepConfig::addDelNodes);
+
+    py::class_<SweepResult>(m, "SweepResult")
+    .def_readonly("config", &SweepResult::config)
+    .def_readonly("name", &SweepResult::name)
+    .def_readonly("generations", &SweepResult::generations)
+    .def_readonly("abandoned", &SweepResult::abandoned)
+    .def_readonly("bestFitness", &SweepResult::bestFitness)
+    .def_readonly("bestPerGeneration", &SweepResult::bestPerGeneration)
+    .def_readonly("meanPerGeneration", &SweepResult::meanPerGeneration)
+    .def_property_readonly("best", [](const SweepResult &self) -> py::object {
+        if (!self.best)
+            return py::none();
+        return py::cast(*self.best); // copy, owned by Python
+    });
+
+    // X is converted once and shared read-only by all populations of the sweep
+    m.def("sweep",
+        [](const std::vector<SweepConfig> &configs,
+           py::array_t<float, py::array::c_style | py::array::forcecast> X,
+           py::array_t<int, py::array::c_style | py::array::forcecast> y,
+           int dMax, std::string metric, int penalty,
+           std::vector<float> minF, std::vector<float> maxF,
+           int generations, int rungGenerations, float eta, unsigned int nThreads) {
+            std::vector<std::vector<float>> vec2d;
+            fill_vec2d_from_numpy(X, vec2d);
+            py::buffer_info ybuf = y.request();
+            if (ybuf.ndim != 1)
+                throw std::runtime_error("y must be a 1D array");
+            int* yptr = static_cast<int*>(ybuf.ptr);
+            std::vector<int> y_vec(yptr, yptr + ybuf.shape[0]);
+            if (minF.empty() && maxF.empty()) {
+                Data data;
+                data.minMaxFeatures(vec2d);
+                minF = data.minX;
+                maxF = data.maxX;
+            }
+
+            std::function<void(Population&)> evaluate;
+            if (metric == "accuracy") {
+                evaluate = [&](Population &p) { p.accuracy(vec2d, y_vec, dMax, penalty); };
+            } else {
+                ConfusionAccumulator::checkMetric(metric);
+                evaluate = [&](Population &p) { p.classificationMetric(vec2d, y_vec, dMax, metric); };
+            }
+            SweepOptions options;
+            options.generations = generations;
+            options.rungGenerations = rungGenerations;
+            options.eta = eta;
+            options.nThreads = nThreads;
+            py::gil_scoped_release release;
+            return runSweep(configs, evaluate, minF, maxF, options);
+        },
+        py::arg("configs"), py::arg("X"), py::arg("y"), py::arg("dMax"),
+        py::arg("metric")="accuracy", py::arg("penalty")=2,
+        py::arg("minF")=std::vector<float>{}, py::arg("maxF")=std::vector<float>{},
+        py::arg("generations")=100, py::arg("rungGenerations")=10,
+        py::arg("eta")=2.0f, py::arg("nThreads")=0);
+
+    // Online tuning of Population.nThreads / Population.chunk: time the first
+    // evaluations with begin()/end() (or evaluate(pop, fn)) and keep the fastest
+    py::class_<ParallelSetting>(m, "ParallelSetting")
+    .def(py::init([](unsigned int nThreads, size_t chunk) { return ParallelSetting{nThreads, chunk}; }),
+         py::arg("nThreads")=0, py::arg("chunk")=1)
+    .def_readwrite("nThreads", &ParallelSetting::nThreads)
+    .def_readwrite("chunk", &ParallelSetting::chunk);
+
+    py::class_<AutotuneStats>(m, "AutotuneStats")
+    .def_readonly("candidates", &AutotuneStats::candidates)
+    .def_readonly("seconds", &AutotuneStats::seconds)
+    .def_readonly("trials", &AutotuneStats::trials)
+    .def_readonly("best", &AutotuneStats::best)
+    .def_readonly("locked", &AutotuneStats::locked)
+    .def_readonly("speedup", &AutotuneStats::speedup);
+
+    py::class_<Autotuner>(m, "Autotuner")
+    .def(py::init<std::vector<ParallelSetting>, size_t>(), py::arg("candidates"), py::arg("trialsPerCandidate")=1)
+    .def_static("defaultCandidates", &Autotuner::defaultCandidates, py::arg("n"))
+    .def("begin", [](Autotuner &self, Population &population) {
+        auto lock = lock_population(population);
+        self.begin(population);
+    }, py::arg("population"))
+    .def("end", [](Autotuner &self, Population &population) {
+        auto lock = lock_population(population);
+        self.end(population);
+    }, py::arg("population"))
+    .def("evaluate", [](Autotuner &self, Population &population, py::function evaluate) {
+        // the population is not locked here: evaluate calls its (locking) methods
+        self.evaluate(population, [&](Population &p) { evaluate(py::cast(&p, py::return_value_policy::reference)); });
+    }, py::arg("population"), py::arg("evaluate"))
+    .def_property_readonly("locked", &Autotuner::locked)
+    .def_property_readonly("best", &Autotuner::best)
+    .def_property_readonly("stats", &Autotuner::stats)
+    .def_readonly("trialsPerCandidate", &Autotuner::trialsPerCandidate);
+
+    // Structural diversity of a population from MinHash sketches (Population.diversity())
+    py::class_<DiversityStats>(m, "DiversityStats")
+    .def_readonly("meanSimilarity", &DiversityStats::meanSimilarity)
+    .def_readonly("diversity", &DiversityStats::diversity)
+    .def_readonly("clusters", &DiversityStats::clusters)
+    .def_readonly("duplicateRatio", &DiversityStats::duplicateRatio)
+    .def_readonly("recomputed", &DiversityStats::recomputed);
+
+    // Genome size limits of a population (Population.budget, Population.enforceBudget())
+    py::class_<GenomeBudget>(m, "GenomeBudget")
+    .def(py::init<>())
+    .def(py::init([](size_t maxNodes, size_t maxBytes) { return GenomeBudget{maxNodes, maxBytes}; }),
+         py::arg("maxNodes")=0, py::arg("maxBytes")=0)
+    .def_readwrite("maxNodes", &GenomeBudget::maxNodes)
+    .def_readwrite("maxBytes", &GenomeBudget::maxBytes)
+    .def("active", &GenomeBudget::active);
+
+    py::class_<MemoryUsage>(m, "MemoryUsage")
+    .def_readonly("nodes", &MemoryUsage::nodes)
+    .def_readonly("bytes", &MemoryUsage::bytes)
+    .def_readonly("largestNetwork", &MemoryUsage::largestNetwork);
+
+    py::class_<BudgetStats>(m, "BudgetStats")
+    .def_readonly("rejectedGrowth", &BudgetStats::rejectedGrowth)
+    .def_readonly("prunedUnreachable", &BudgetStats::prunedUnreachable)
+    .def_readonly("prunedUnused", &BudgetStats::prunedUnused);
+
+    // Hit statistics of the inference cache of a deployed network (Network.setDecisionCache())
+    py::class_<DecisionCacheStats>(m, "DecisionCacheStats")
+    .def_readonly("hits", &DecisionCacheStats::hits)
+    .def_readonly("misses", &DecisionCacheStats::misses)
+    .def_readonly("bypassed", &DecisionCacheStats::bypassed)
+    .def_readonly("evictions", &DecisionCacheStats::evictions)
+    .def_readonly("rebuilds", &DecisionCacheStats::rebuilds)
+    .def("hitRate", &DecisionCacheStats::hitRate);
+
+    // Behaviour signatures with an LSH index for novelty search
+    // (Population.noveltyObjective()); signatures are lists of 64-bit words
+    py::class_<BehaviorArchive>(m, "BehaviorArchive")
+    .def(py::init<size_t, size_t, size_t, size_t, uint64_t>(),
+         py::arg("nWords")=1, py::arg("nBands")=8, py::arg("k")=15, py::arg("capacity")=10000, py::arg("seed")=0)
+    .def("__len__", &BehaviorArchive::size)
+    .def_readonly("nWords", &BehaviorArchive::nWords)
+    .def_readonly("nBands", &BehaviorArchive::nBands)
+    .def_readwrite("k", &BehaviorArchive::k)
+    .def_readonly("capacity", &BehaviorArchive::capacity)
+    .def_static("quantise", &BehaviorArchive::quantise, py::arg("values"), py::arg("quantum"))
+    .def_static("distance", &BehaviorArchive::distance, py::arg("a"), py::arg("b"))
+    .def("signature", &BehaviorArchive::signature, py::arg("descriptor"))
+    .def("novelty", &BehaviorArchive::novelty, py::arg("signature"))
+    .def("add", &BehaviorArchive::add, py::arg("signature"))
+    .def("clear", &BehaviorArchive::clear)
+    .def("entries", &BehaviorArchive::entries);
+
+    // k-NN fitness surrogate for pre-screening offspring: screen() selects the
+    // individuals to evaluate (e.g. on pop.subset(selected)), update() retrains.
+    py::class_<Surrogate>(m, "Surrogate")
+    .def(py::init<size_t, size_t, size_t>(), py::arg("k")=5, py::arg("capacity")=2000, py::arg("minSamples")=0)
+    .def_readwrite("k", &Surrogate::k)
+    .def_readwrite("capacity", &Surrogate::capacity)
+    .def_readwrite("minSamples", &Surrogate::minSamples)
+    .def("__len__", &Surrogate::size)
+    .def_property_readonly("screenedOut", &Surrogate::screenedOut)
+    .def("add", &Surrogate::add, py::arg("features"), py::arg("fitness"))
+    .def("fit", &Surrogate::fit)
+    .def("predict", &Surrogate::predict, py::arg("features"))
+    .def("screen",
+        [](Surrogate &self, Population &population,
+           py::array_t<float, py::array::c_style | py::array::forcecast> probe,
+           int dMax, float fraction, float worstFitness) {
+            thread_local std::vector<std::vector<float>> vec2d;
+            fill_vec2d_from_numpy(probe, vec2d);
+            auto lock = lock_population(population);
+            py::gil_scoped_release release;
+            return self.screen(population, vec2d, dMax, fraction, worstFitness);
+        },
+        py::arg("population"), py::arg("probe"), py::arg("dMax"), py::arg("fraction"), py::arg("worstFitness"))
+    .def("update",
+        [](Surrogate &self, const Population &population, const std::vector<int> &evaluated) {
+            auto lock = lock_population(population);
+            py::gil_scoped_release release;
+            self.update(population, evaluated);
+        },
+        py::arg("population"), py::arg("evaluated"));
+
+    // Flat genome of a network; the array properties are views without copies.
+    // Structural changes (other number of nodes or edges) build a new GenomeView.
+    py::class_<GenomeView>(m, "GenomeView")
+    .def(py::init([](py::array_t<uint8_t, py::array::c_style | py::array::forcecast> types,
+                     py::array_t<int32_t, py::array::c_style | py::array::forcecast> functions,
+                     py::array_t<int64_t, py::array::c_style | py::array::forcecast> edgeOffsets,
+                     py::array_t<int32_t, py::array::c_style | py::array::forcecast> edgeTargets,
+                     py::array_t<int64_t, py::array::c_style | py::array::forcecast> boundaryOffsets,
+                     py::array_t<double, py::array::c_style | py::array::forcecast> boundaryValues,
+                     int32_t startEdge) {
+            GenomeView view;
+            view.types = vector_from_numpy<uint8_t>(types);
+            view.functions = vector_from_numpy<int32_t>(functions);
+            view.edgeOffsets = vector_from_numpy<int64_t>(edgeOffsets);
+            view.edgeTargets = vector_from_numpy<int32_t>(edgeTargets);
+            view.boundaryOffsets = vector_from_numpy<int64_t>(boundaryOffsets);
+            view.boundaryValues = vector_from_numpy<double>(boundaryValues);
+            view.startEdge = startEdge;
+            return view;
+        }),
+        py::arg("types"), py::arg("functions"), py::arg("edgeOffsets"), py::arg("edgeTargets"),
+        py::arg("boundaryOffsets"), py::arg("boundaryValues"), py::arg("startEdge"))
+    .def_property_readonly("types", [](py::object self) {
+        return genome_array(self, self.cast<GenomeView&>().types);
+    })
+    .def_property_readonly("functions", [](py::object self) {
+        return genome_array(self, self.cast<GenomeView&>().functions);
+    })
+    .def_property_readonly("edgeOffsets", [](py::object self) {
+        return genome_array(self, self.cast<GenomeView&>().edgeOffsets);
+    })
+    .def_property_readonly("edgeTargets", [](py::object self) {
+        return genome_array(self, self.cast<GenomeView&>().edgeTargets);
+    })
+    .def_property_readonly("boundaryOffsets", [](py::object self) {
+        return genome_array(self, self.cast<GenomeView&>().boundaryOffsets);
+    })
+    .def_property_readonly("boundaryValues", [](py::object self) {
+        return genome_array(self, self.cast<GenomeView&>().boundaryValues);
+    })
+    .def_readwrite("startEdge", &GenomeView::startEdge)
+    .def("validate", &GenomeView::validate, py::arg("jnf"), py::arg("pnf"))
+    .def("applyTo", &GenomeView::applyTo, py::arg("network"))
+    .def("__len__", &GenomeView::size);
+
     py::class_<Network>(m, "Network")
     .def(py::init<
             std::shared_ptr<std::mt19937_64>,
@@ -116,15 +605,31 @@ PYBIND11_MODULE(_core, m) {
     .def_readwrite("pn", &Network::pn)
     .def_readwrite("pnf", &Network::pnf)
     .def_readwrite("fractalJudgment", &Network::fractalJudgment)
-    .def_readwrite("innerNodes", &Network::innerNodes)
-    .def_readwrite("startNode", &Network::startNode)
+    // assigning innerNodes or startNode invalidates the cached evaluation state
+    // (Network::genomeChanged()); in-place edits such as net.startNode.edges = [...]
+    // must call net.genomeChanged() themselves (innerNodes is returned as a copy)
+    .def_property("innerNodes",
+        [](const Network &self) { return self.innerNodes; },
+        [](Network &self, const std::vector<Node> &nodes) {
+            self.innerNodes = nodes;
+            self.genomeChanged();
+        })
+    .def_property("startNode",
+        [](Network &self) -> Node& { return self.startNode; },
+        [](Network &self, const Node &node) {
+            self.startNode = node;
+            self.genomeChanged();
+        },
+        py::return_value_policy::reference_internal)
     .def_readwrite("fitness", &Network::fitness)
     .def_readwrite("fitnessValues", &Network::fitnessValues)
     .def_readwrite("objectives", &Network::objectives)       // Pareto objectives
     .def_readwrite("lastStepRewards", &Network::lastStepRewards)
     .def_readwrite("decisions", &Network::decisions)
+    .def_readwrite("behavior", &Network::behavior)            // novelty descriptor
     .def_readwrite("currentNodeID", &Network::currentNodeID)
     .def_readwrite("invalid", &Network::invalid)
+    .def_readonly("truncated", &Network::truncated)
     .def_readwrite("nBest", &Network::nBest)
     .def_readwrite("nConsecutiveP", &Network::nConsecutiveP)
     .def_readwrite("nCrossovers", &Network::nCrossovers)
@@ -134,6 +639,10 @@ PYBIND11_MODULE(_core, m) {
             return self.decisionAndNextNode(obs, dMax);
         },
     py::arg("obs"), py::arg("dMax"))
+    .def("setDecisionCache", &Network::setDecisionCache, py::arg("capacity"))
+    .def_property_readonly("decisionCacheStats",
+        [](const Network &self) { return self.decisionCache.stats(); })
+    .def("resetDecisionCacheStats", [](Network &self) { self.decisionCache.resetStats(); })
     .def("traversePath",
         [](Network &self, py::array_t<float, py::array::c_style | py::array::forcecast> X, int dMax) {
             thread_local std::vector<std::vector<float>> vec2d;
@@ -144,7 +653,41 @@ PYBIND11_MODULE(_core, m) {
             }
         },
         py::arg("X"), py::arg("dMax"))
+    .def("traversePathCompact",
+        [](Network &self, py::array_t<float, py::array::c_style | py::array::forcecast> X, int dMax) {
+            thread_local std::vector<std::vector<float>> vec2d;
+            fill_vec2d_from_numpy(X, vec2d);
+            {
+                py::gil_scoped_release release;
+                self.traversePathCompact(vec2d, dMax);
+            }
+        },
+        py::arg("X"), py::arg("dMax"))
+    .def("traversePathStream",
+        // callback(row, decision) per row without storing decisions; decision is None on invalid rows
+        [](Network &self, py::array_t<float, py::array::c_style | py::array::forcecast> X, int dMax,
+           py::function callback) {
+            std::vector<std::vector<float>> vec2d;
+            fill_vec2d_from_numpy(X, vec2d);
+            self.traversePath(vec2d, dMax, [&](size_t row, int dec, bool valid) {
+                callback(row, valid ? py::object(py::int_(dec)) : py::object(py::none()));
+            });
+        },
+        py::arg("X"), py::arg("dMax"), py::arg("callback"))
+    .def_property_readonly("seedHistory",
+        [](Network &self) -> SeedHistory& { return self.seedHistory; },
+        py::return_value_policy::reference_internal)
+    .def_property_readonly("compactDecisions",
+        [](Network &self) -> const DecisionBuffer& { return self.compactDecisions; },
+        py::return_value_policy::reference_internal)
     .def("clearUsedNodes", &Network::clearUsedNodes)
+    .def("genomeChanged", &Network::genomeChanged)
+    .def("minHash", [](Network &self, size_t K) { return self.minHash(K).values; }, py::arg("K")=64)
+    .def("pruneUnreachable", &Network::pruneUnreachable)
+    .def("pruneUnused", &Network::pruneUnused, py::arg("maxRemove"))
+    .def("genomeBytes", &Network::genomeBytes)
+    .def("genomeView", &GenomeView::fromNetwork)
+    .def("applyGenome", [](Network &self, const GenomeView &view) { view.applyTo(self); }, py::arg("view"))
         // Pickle support – fixed: tuple has 12 elements (indices 0-11)
     .def(py::pickle(
         [](const Network &n) { // __getstate__
@@ -225,34 +768,99 @@ PYBIND11_MODULE(_core, m) {
         .def_readwrite("meanFitness", &Population::meanFitness)
         .def_readwrite("minFitness", &Population::minFitness)
         .def_readwrite("maxNetworkSize", &Population::maxNetworkSize)
+        .def_readwrite("nThreads", &Population::nThreads)
+        .def_readwrite("chunk", &Population::chunk)
+        // budget and seedPool are copied under the lock; change them by assigning
+        // the whole object (pool = pop.seedPool; pool.rolling = [...]; pop.seedPool = pool),
+        // so no write bypasses the guard.
+        .def_property("budget",
+            [](Population &self) { auto lock = lock_population(self); return self.budget; },
+            [](Population &self, const GenomeBudget &budget) {
+                auto lock = lock_population(self);
+                self.budget = budget;
+            })
+        .def_property_readonly("budgetStats",
+            [](Population &self) { auto lock = lock_population(self); return self.budgetStats; })
+        .def_property("seedPool",
+            [](Population &self) { auto lock = lock_population(self); return self.seedPool; },
+            [](Population &self, const SeedPool &pool) {
+                auto lock = lock_population(self);
+                self.seedPool = pool;
+            })
         // Use def_property with return_value_policy::reference instead of
         // def_readwrite (which uses reference_internal / keep_alive).
         // reference_internal calls add_patient() on every property access,
         // accumulating Py_INCREF entries in pybind11's internals.patients map.
         // With plain reference, the wrapper simply points to the member
         // without adding keep_alive bookkeeping each time.
+        // Rejected while the individuals are borrowed by a view or being evaluated;
+        // the returned vector is a live reference (see the note on locking above).
         .def_property("individuals",
             [](Population &self) -> std::vector<Network>& {
+                auto lock = lock_population(self);
                 return self.individuals;
             },
             [](Population &self, py::object v) {
+                std::vector<Network> tmp;
                 if (py::isinstance<std::vector<Network>>(v)) {
                     // Direct assignment from NetworkVector
-                    self.individuals = v.cast<std::vector<Network>&>();
+                    tmp = v.cast<std::vector<Network>&>();
                 } else {
                     // Accept any Python sequence of Network objects (e.g. list)
                     py::sequence seq = v.cast<py::sequence>();
-                    std::vector<Network> tmp;
                     tmp.reserve(py::len(seq));
                     for (auto item : seq)
                         tmp.push_back(item.cast<Network>());
-                    self.individuals = std::move(tmp);
                 }
+                auto lock = lock_population(self);
+                self.individuals = std::move(tmp);
             },
 
             py::return_value_policy::reference)
         .def_readwrite("nFeatureValues", &Population::nFeatureValues)
 
+        // Bulk accessors: one numpy array per call instead of one Python object
+        // per individual (reading innerNodes alone copies the whole node vector).
+        .def("fitnessArray", [](const Population &self) {
+            return population_column<float>(self, [](const Network &n) { return n.fitness; });
+        })
+        .def("invalidArray", [](const Population &self) {
+            return population_column<bool>(self, [](const Network &n) { return n.invalid; });
+        })
+        .def("truncatedArray", [](const Population &self) {
+            return population_column<bool>(self, [](const Network &n) { return n.truncated; });
+        })
+        .def("networkSizeArray", [](const Population &self) {
+            return population_column<int32_t>(self, [](const Network &n) { return n.innerNodes.size(); });
+        })
+        .def("usedNodesArray", [](const Population &self) {
+            return population_column<int32_t>(self, [](const Network &n) {
+                return std::count_if(n.innerNodes.begin(), n.innerNodes.end(),
+                                     [](const Node &node) { return node.used; });
+            });
+        })
+        .def("crossoverArray", [](const Population &self) {
+            return population_column<uint64_t>(self, [](const Network &n) { return n.nCrossovers; });
+        })
+        .def("objectivesArray", [](const Population &self) {
+            // (ni x M) with M the largest number of objectives; shorter rows are NaN-padded
+            auto lock = lock_population(self);
+            size_t m = 0;
+            for (const auto &n : self.individuals)
+                m = std::max(m, n.objectives.size());
+            py::array_t<float> out({static_cast<py::ssize_t>(self.individuals.size()),
+                                    static_cast<py::ssize_t>(m)});
+            auto view = out.mutable_unchecked<2>();
+            for (size_t i = 0; i < self.individuals.size(); ++i) {
+                const auto &objectives = self.individuals[i].objectives;
+                for (size_t j = 0; j < m; ++j) {
+                    view(i, j) = j < objectives.size() ? objectives[j]
+                                                       : std::numeric_limits<float>::quiet_NaN();
+                }
+            }
+            return out;
+        })
+
         // Functions
         .def(
             "setAllNodeBoundaries",
@@ -269,6 +877,7 @@ PYBIND11_MODULE(_core, m) {
 
                 {
                     py::gil_scoped_release release;
+                    auto lock = lock_idle_population(p);
                     p.setAllNodeBoundaries(minF, maxF);
                 }
             },
@@ -277,15 +886,152 @@ PYBIND11_MODULE(_core, m) {
         )
 
         .def("callTraversePath",
-            [](Population &self, py::array_t<float, py::array::c_style | py::array::forcecast> X, int dMax) {
+            [](Population &self, py::array_t<float, py::array::c_style | py::array::forcecast> X, int dMax,
+               bool compact) {
+                thread_local std::vector<std::vector<float>> vec2d;
+                fill_vec2d_from_numpy(X, vec2d);
+                {
+                    py::gil_scoped_release release;
+                    auto lock = lock_idle_population(self);
+                    self.callTraversePath(vec2d, dMax, compact);
+                }
+            },
+            py::arg("X"), py::arg("dMax"), py::arg("compact")=false)
+
+        .def("evaluateDecisions",
+            [](Population &self,
+               py::array_t<float, py::array::c_style | py::array::forcecast> X,
+               py::function fitness_fn, int dMax) {
+                thread_local std::vector<std::vector<float>> vec2d;
+                fill_vec2d_from_numpy(X, vec2d);
+                // released around the Python callback, so fitness_fn may use the population
+                // (pop.fitnessArray(), pop.individuals, ...); assignFitness() rejects the
+                // result if the callback changed the number of individuals
+                auto lock = lock_population(self);
+                py::ssize_t ni = static_cast<py::ssize_t>(self.individuals.size());
+                py::ssize_t rows = static_cast<py::ssize_t>(vec2d.size());
+
+                // narrowest signed dtype that holds all processing node functions and -1
+                auto evaluate = [&](auto tag) {
+                    using T = decltype(tag);
+                    py::array_t<T> decisions({ni, rows});
+                    T* out = decisions.mutable_data();
+                    {
+                        py::gil_scoped_release release;
+                        self.decisionMatrix(vec2d, dMax, out);
+                    }
+                    lock.unlock();
+                    py::array_t<float, py::array::c_style | py::array::forcecast> fitness =
+                        fitness_fn(decisions);
+                    py::buffer_info fbuf = fitness.request();
+                    if (fbuf.ndim != 1)
+                        throw std::runtime_error("fitness_fn must return a 1D array");
+                    float* fptr = static_cast<float*>(fbuf.ptr);
+                    lock = lock_population(self);
+                    self.assignFitness(std::vector<float>(fptr, fptr + fbuf.shape[0]));
+                };
+                if (self.pnf <= std::numeric_limits<int8_t>::max())
+                    evaluate(int8_t{});
+                else if (self.pnf <= std::numeric_limits<int16_t>::max())
+                    evaluate(int16_t{});
+                else
+                    evaluate(int32_t{});
+            },
+            py::arg("X"), py::arg("fitness_fn"), py::arg("dMax"))
+
+        .def("evaluateAsync",
+            [](Population &self,
+               std::string fitness,
+               py::array_t<float, py::array::c_style | py::array::forcecast> X,
+               py::array_t<float, py::array::c_style | py::array::forcecast> targets,
+               int dMax, float worstFitness) {
+                // the task owns copies of the data: Python continues while it runs
+                std::vector<std::vector<float>> vec2d;
+                fill_vec2d_from_numpy(X, vec2d);
+                py::buffer_info tbuf = targets.request();
+                if (tbuf.ndim != 1 && tbuf.ndim != 2)
+                    throw std::runtime_error("targets must be a 1D or 2D array");
+                size_t nCols = tbuf.size == 0 ? 0 : (tbuf.ndim == 1 ? 1 : static_cast<size_t>(tbuf.shape[1]));
+                float* tptr = static_cast<float*>(tbuf.ptr);
+                std::vector<float> t_vec(tptr, tptr + tbuf.size);
+
+                std::function<void(Population&)> task;
+                if (fitness == "accuracy" || fitness == "balancedAccuracy" || fitness == "macroF1" || fitness == "kappa") {
+                    std::vector<int> y_vec(t_vec.begin(), t_vec.end());
+                    task = [vec2d = std::move(vec2d), y_vec = std::move(y_vec), dMax, fitness](Population &p) {
+                        p.classificationMetric(vec2d, y_vec, dMax, fitness);
+                    };
+                } else {
+                    FitnessRegistry::instance().find(fitness); // unknown names fail here, not in wait()
+                    task = [vec2d = std::move(vec2d), t_vec = std::move(t_vec), nCols, dMax, worstFitness, fitness](Population &p) {
+                        p.nativeFitness(fitness, vec2d, t_vec, nCols, dMax, worstFitness);
+                    };
+                }
+                py::gil_scoped_release release;
+                return evaluateAsync(self, std::move(task));
+            },
+            py::keep_alive<0, 1>(), // the handle keeps the population alive
+            py::arg("fitness"), py::arg("X"), py::arg("targets"), py::arg("dMax"), py::arg("worstFitness")=0.0f)
+
+        .def("classificationMetric",
+            [](Population &self,
+               py::array_t<float, py::array::c_style | py::array::forcecast> X,
+               py::array_t<int, py::array::c_style | py::array::forcecast> y,
+               int dMax, std::string metric, bool returnConfusion) -> py::object {
+                thread_local std::vector<std::vector<float>> vec2d;
+                fill_vec2d_from_numpy(X, vec2d);
+
+                py::buffer_info ybuf = y.request();
+                if (ybuf.ndim != 1)
+                    throw std::runtime_error("y must be a 1D array");
+                int* yptr = static_cast<int*>(ybuf.ptr);
+                std::vector<int> y_vec(yptr, yptr + ybuf.shape[0]);
+
+                auto lock = lock_population(self);
+                std::vector<uint32_t> confusion;
+                size_t nClasses;
+                {
+                    py::gil_scoped_release release;
+                    nClasses = self.classificationMetric(vec2d, y_vec, dMax, metric,
+                                                         returnConfusion ? &confusion : nullptr);
+                }
+                if (!returnConfusion)
+                    return py::none();
+                // (ni x nClasses x nClasses), rows are true classes
+                py::ssize_t c = static_cast<py::ssize_t>(nClasses);
+                py::array_t<uint32_t> out({static_cast<py::ssize_t>(self.individuals.size()), c, c});
+                std::copy(confusion.begin(), confusion.end(), out.mutable_data());
+                return out;
+            },
+            py::arg("X"), py::arg("y"), py::arg("dMax"), py::arg("metric")="balancedAccuracy",
+            py::arg("returnConfusion")=false)
+
+        .def("nativeFitness",
+            [](Population &self,
+               std::string name,
+               py::array_t<float, py::array::c_style | py::array::forcecast> X,
+               py::array_t<float, py::array::c_style | py::array::forcecast> targets,
+               int dMax, float worstFitness) {
                 thread_local std::vector<std::vector<float>> vec2d;
                 fill_vec2d_from_numpy(X, vec2d);
+
+                // targets: 1D (one value per row) or 2D (rows x columns), row-major
+                py::buffer_info tbuf = targets.request();
+                if (tbuf.ndim != 1 && tbuf.ndim != 2)
+                    throw std::runtime_error("targets must be a 1D or 2D array");
+                size_t nCols = tbuf.ndim == 1 ? 1 : static_cast<size_t>(tbuf.shape[1]);
+                if (tbuf.size == 0)
+                    nCols = 0;
+                float* tptr = static_cast<float*>(tbuf.ptr);
+                std::vector<float> t_vec(tptr, tptr + tbuf.size);
+
                 {
                     py::gil_scoped_release release;
-                    self.callTraversePath(vec2d, dMax);
+                    auto lock = lock_idle_population(self);
+                    self.nativeFitness(name, vec2d, t_vec, nCols, dMax, worstFitness);
                 }
             },
-            py::arg("X"), py::arg("dMax"))
+            py::arg("name"), py::arg("X"), py::arg("targets"), py::arg("dMax"), py::arg("worstFitness"))
 
         .def("accuracy",
             [](Population &self,
@@ -303,11 +1049,139 @@ PYBIND11_MODULE(_core, m) {
 
                 {
                     py::gil_scoped_release release;
+                    auto lock = lock_idle_population(self);
                     self.accuracy(vec2d, y_vec, dMax, penalty);
                 }
             },
             py::arg("X"), py::arg("y"), py::arg("dMax"), py::arg("penalty"))
 
+        .def("accuracy",
+            [](Population &self,
+               const Data &data,
+               py::array_t<int, py::array::c_style | py::array::forcecast> y,
+               int dMax, int penalty) {
+                py::buffer_info ybuf = y.request();
+                if (ybuf.ndim != 1)
+                    throw std::runtime_error("y must be a 1D array");
+                if (static_cast<size_t>(ybuf.shape[0]) > data.X.size())
+                    throw std::runtime_error("y has more rows than data.X");
+                int* yptr = static_cast<int*>(ybuf.ptr);
+                std::vector<int> y_vec(yptr, yptr + ybuf.shape[0]);
+
+                {
+                    py::gil_scoped_release release;
+                    auto lock = lock_idle_population(self);
+                    self.accuracy(data, y_vec, dMax, penalty);
+                }
+            },
+            py::arg("data"), py::arg("y"), py::arg("dMax"), py::arg("penalty"))
+
+        .def("backtest",
+            [](Population &self,
+               py::array_t<float, py::array::c_style | py::array::forcecast> X,
+               py::array_t<float, py::array::c_style | py::array::forcecast> returns,
+               std::vector<float> positions,
+               int dMax, float worstFitness, float cost,
+               std::string metric, float periodsPerYear) {
+                thread_local std::vector<std::vector<float>> vec2d;
+                fill_vec2d_from_numpy(X, vec2d);
+
+                py::buffer_info rbuf = returns.request();
+                if (rbuf.ndim != 1)
+                    throw std::runtime_error("returns must be a 1D array");
+                float* rptr = static_cast<float*>(rbuf.ptr);
+                std::vector<float> r_vec(rptr, rptr + rbuf.shape[0]);
+
+                {
+                    py::gil_scoped_release release;
+                    auto lock = lock_idle_population(self);
+                    self.backtest(vec2d, r_vec, positions, dMax, worstFitness, cost, metric, periodsPerYear);
+                }
+            },
+            py::arg("X"), py::arg("returns"), py::arg("positions"), py::arg("dMax"), py::arg("worstFitness"),
+            py::arg("cost")=0.0f, py::arg("metric")="sharpe", py::arg("periodsPerYear")=252.0f)
+
+        .def("multiSeriesAccuracy",
+            [](Population &self,
+               py::array_t<float, py::array::c_style | py::array::forcecast> X,
+               py::array_t<int, py::array::c_style | py::array::forcecast> y,
+               std::vector<size_t> offsets,
+               int dMax, std::string aggregation, float q) {
+                thread_local std::vector<std::vector<float>> vec2d;
+                fill_vec2d_from_numpy(X, vec2d);
+
+                py::buffer_info ybuf = y.request();
+                if (ybuf.ndim != 1)
+                    throw std::runtime_error("y must be a 1D array");
+                int* yptr = static_cast<int*>(ybuf.ptr);
+                std::vector<int> y_vec(yptr, yptr + ybuf.shape[0]);
+
+                {
+                    py::gil_scoped_release release;
+                    auto lock = lock_idle_population(self);
+                    self.multiSeriesAccuracy(vec2d, y_vec, offsets, dMax, aggregation, q);
+                }
+            },
+            py::arg("X"), py::arg("y"), py::arg("offsets"), py::arg("dMax"),
+            py::arg("aggregation")="mean", py::arg("q")=0.5f)
+
+        .def("multiSeriesBacktest",
+            [](Population &self,
+               py::array_t<float, py::array::c_style | py::array::forcecast> X,
+               py::array_t<float, py::array::c_style | py::array::forcecast> returns,
+               std::vector<size_t> offsets,
+               std::vector<float> positions,
+               int dMax, float worstFitness, float cost,
+               std::string metric, float periodsPerYear,
+               std::string aggregation, float q) {
+                thread_local std::vector<std::vector<float>> vec2d;
+                fill_vec2d_from_numpy(X, vec2d);
+
+                py::buffer_info rbuf = returns.request();
+                if (rbuf.ndim != 1)
+                    throw std::runtime_error("returns must be a 1D array");
+                float* rptr = static_cast<float*>(rbuf.ptr);
+                std::vector<float> r_vec(rptr, rptr + rbuf.shape[0]);
+
+                {
+                    py::gil_scoped_release release;
+                    auto lock = lock_idle_population(self);
+                    self.multiSeriesBacktest(vec2d, r_vec, offsets, positions, dMax, worstFitness,
+                                             cost, metric, periodsPerYear, aggregation, q);
+                }
+            },
+            py::arg("X"), py::arg("returns"), py::arg("offsets"), py::arg("positions"), py::arg("dMax"),
+            py::arg("worstFitness"), py::arg("cost")=0.0f, py::arg("metric")="sharpe",
+            py::arg("periodsPerYear")=252.0f, py::arg("aggregation")="mean", py::arg("q")=0.5f)
+
+        .def("crossValidationAccuracy",
+            [](Population &self,
+               py::array_t<float, py::array::c_style | py::array::forcecast> X,
+               py::array_t<int, py::array::c_style | py::array::forcecast> y,
+               const std::vector<Fold>& folds,
+               int dMax, std::string part, std::string aggregation, float q) {
+                thread_local std::vector<std::vector<float>> vec2d;
+                fill_vec2d_from_numpy(X, vec2d);
+
+                py::buffer_info ybuf = y.request();
+                if (ybuf.ndim != 1)
+                    throw std::runtime_error("y must be a 1D array");
+                int* yptr = static_cast<int*>(ybuf.ptr);
+                std::vector<int> y_vec(yptr, yptr + ybuf.shape[0]);
+
+                {
+                    py::gil_scoped_release release;
+                    auto lock = lock_idle_population(self);
+                    self.crossValidationAccuracy(vec2d, y_vec, folds, dMax, part, aggregation, q);
+                }
+            },
+            py::arg("X"), py::arg("y"), py::arg("folds"), py::arg("dMax"),
+            py::arg("part")="test", py::arg("aggregation")="mean", py::arg("q")=0.5f)
+
+        .def("streamingAccuracy", locked(&Population::streamingAccuracy),
+             py::call_guard<py::gil_scoped_release>(),
+             py::arg("window"), py::arg("dMax"), py::arg("reanchorInterval")=1000)
+
         .def("gymnasium",
                 [](Population &self,
                     py::object env,
@@ -315,15 +1189,20 @@ PYBIND11_MODULE(_core, m) {
                     int maxSteps,
                     int maxConsecutiveP,
                     int worstFitness,
-                    int seed
+                    int seed,
+                    std::optional<double> threshold,
+                    std::optional<double> maxStepReward
                     ) {
+                        auto lock = lock_population(self);
                         GymEnvWrapper wrapper(env);
-                        self.gymnasium(wrapper, dMax, maxSteps, maxConsecutiveP, worstFitness, seed);
+                        self.gymnasium(wrapper, dMax, maxSteps, maxConsecutiveP, worstFitness, seed,
+                                       make_episode_bound(threshold, maxStepReward));
                         // Force GC to reclaim cyclic garbage from env.step()/env.reset()
                         // calls that accumulate over the population loop.
                         force_gc_collect();
                     },
-                py::arg("env"), py::arg("dMax"), py::arg("maxSteps"), py::arg("maxConsecutiveP"), py::arg("worstFitness"), py::arg("seed")
+                py::arg("env"), py::arg("dMax"), py::arg("maxSteps"), py::arg("maxConsecutiveP"), py::arg("worstFitness"), py::arg("seed"),
+                py::arg("threshold")=py::none(), py::arg("maxStepReward")=py::none()
             )
 
         .def("gymnasiumMultiSeed",
@@ -333,41 +1212,109 @@ PYBIND11_MODULE(_core, m) {
                     int maxSteps,
                     int maxConsecutiveP,
                     int worstFitness,
-                    std::vector<int> seeds
+                    std::vector<int> seeds,
+                    std::optional<double> threshold,
+                    std::optional<double> maxStepReward
                     ) {
+                        auto lock = lock_population(self);
                         GymEnvWrapper wrapper(env);
-                        self.gymnasiumMultiSeed(wrapper, dMax, maxSteps, maxConsecutiveP, worstFitness, seeds);
+                        self.gymnasiumMultiSeed(wrapper, dMax, maxSteps, maxConsecutiveP, worstFitness, seeds,
+                                                make_episode_bound(threshold, maxStepReward));
                         // Force GC to reclaim cyclic garbage from env.step()/env.reset()
                         // calls that accumulate over population × seeds loops.
                         force_gc_collect();
                     },
-                py::arg("env"), py::arg("dMax"), py::arg("maxSteps"), py::arg("maxConsecutiveP"), py::arg("worstFitness"), py::arg("seeds")
+                py::arg("env"), py::arg("dMax"), py::arg("maxSteps"), py::arg("maxConsecutiveP"), py::arg("worstFitness"), py::arg("seeds"),
+                py::arg("threshold")=py::none(), py::arg("maxStepReward")=py::none()
             )
 
-        .def("calculateParetoObjectives", &Population::calculateParetoObjectives,
+        .def("subset",
+            [](Population &self, std::vector<int> indices) {
+                return std::make_unique<PopulationView>(self, std::move(indices));
+            },
+            py::call_guard<py::gil_scoped_release>(),
+            py::keep_alive<0, 1>(),
+            py::arg("indices"))
+
+        .def("copySubset",
+            [](const Population &self, const std::vector<int> &indices) {
+                auto lock = lock_idle_population(self);
+                return self.copySubset(indices);
+            },
+            py::call_guard<py::gil_scoped_release>(),
+            py::arg("indices"))
+
+        .def("setSeedHistoryCapacity", locked(&Population::setSeedHistoryCapacity),
+             py::call_guard<py::gil_scoped_release>(),
+             py::arg("capacity"))
+
+        .def("rollSeedPool", locked(&Population::rollSeedPool),
+             py::call_guard<py::gil_scoped_release>(),
+             py::arg("n")=1)
+
+        .def("gymnasiumSeedHistory",
+                [](Population &self,
+                    py::object env,
+                    int dMax,
+                    int maxSteps,
+                    int maxConsecutiveP,
+                    int worstFitness,
+                    std::vector<int> seeds,
+                    const std::string &aggregation,
+                    float param,
+                    std::optional<double> threshold,
+                    std::optional<double> maxStepReward
+                    ) {
+                        auto lock = lock_population(self);
+                        GymEnvWrapper wrapper(env);
+                        self.gymnasiumSeedHistory(wrapper, dMax, maxSteps, maxConsecutiveP, worstFitness, seeds,
+                                                  aggregation, param, make_episode_bound(threshold, maxStepReward));
+                        force_gc_collect();
+                    },
+                py::arg("env"), py::arg("dMax"), py::arg("maxSteps"), py::arg("maxConsecutiveP"), py::arg("worstFitness"), py::arg("seeds"),
+                py::arg("aggregation")="mean", py::arg("param")=0.5f,
+                py::arg("threshold")=py::none(), py::arg("maxStepReward")=py::none()
+            )
+
+        .def("calculateParetoObjectives", locked(&Population::calculateParetoObjectives),
              py::call_guard<py::gil_scoped_release>(),
              py::arg("landingThreshold")=100.0f)
 
-        .def("paretoTournamentSelection", &Population::paretoTournamentSelection,
+        .def("paretoTournamentSelection", locked(&Population::paretoTournamentSelection),
              py::call_guard<py::gil_scoped_release>(),
              py::arg("N"), py::arg("E_reward"), py::arg("E_landing"))
 
-        .def("tournamentSelection", &Population::tournamentSelection,
+        .def("diversity", locked(&Population::diversity),
+             py::call_guard<py::gil_scoped_release>(),
+             py::arg("K")=64, py::arg("nBands")=16)
+
+        .def("memoryUsage", locked(&Population::memoryUsage),
+             py::call_guard<py::gil_scoped_release>())
+        .def("enforceBudget", locked(&Population::enforceBudget),
+             py::call_guard<py::gil_scoped_release>(),
+             py::arg("pruneUnused")=true)
+
+        .def("noveltyObjective", locked(&Population::noveltyObjective),
+             py::call_guard<py::gil_scoped_release>(),
+             py::arg("archive"), py::arg("descriptor")="decisions", py::arg("quantum")=1.0f,
+             py::arg("nArchive")=1, py::arg("extend")=false)
+
+        .def("tournamentSelection", locked(&Population::tournamentSelection),
              py::call_guard<py::gil_scoped_release>(),
              py::arg("N"), py::arg("E"))
-        .def("callEdgeMutation", &Population::callEdgeMutation,
+        .def("callEdgeMutation", locked(&Population::callEdgeMutation),
              py::call_guard<py::gil_scoped_release>(),
              py::arg("probInnerNodes"), py::arg("probStartNode"), py::arg("justUsedNodes")=false, py::arg("k")=0)
-        .def("callBoundaryMutationNormal", &Population::callBoundaryMutationNormal,
+        .def("callBoundaryMutationNormal", locked(&Population::callBoundaryMutationNormal),
              py::call_guard<py::gil_scoped_release>(),
              py::arg("probability"), py::arg("sigma"), py::arg("justUsedNodes")=false)
-        .def("callBoundaryMutationUniform", &Population::callBoundaryMutationUniform,
+        .def("callBoundaryMutationUniform", locked(&Population::callBoundaryMutationUniform),
              py::call_guard<py::gil_scoped_release>(),
              py::arg("probability"), py::arg("justUsedNodes")=false)
-        .def("callBoundaryMutationNetworkSizeDependingSigma", &Population::callBoundaryMutationNetworkSizeDependingSigma,
+        .def("callBoundaryMutationNetworkSizeDependingSigma", locked(&Population::callBoundaryMutationNetworkSizeDependingSigma),
              py::call_guard<py::gil_scoped_release>(),
              py::arg("probability"), py::arg("sigma"), py::arg("justUsedNodes")=false)
-        .def("callBoundaryMutationEdgeSizeDependingSigma", &Population::callBoundaryMutationEdgeSizeDependingSigma,
+        .def("callBoundaryMutationEdgeSizeDependingSigma", locked(&Population::callBoundaryMutationEdgeSizeDependingSigma),
              py::call_guard<py::gil_scoped_release>(),
              py::arg("probability"), py::arg("sigma"), py::arg("justUsedNodes")=false)
         .def(
@@ -385,6 +1332,7 @@ PYBIND11_MODULE(_core, m) {
 
                 {
                     py::gil_scoped_release release;
+                    auto lock = lock_idle_population(p);
                     p.callBoundaryMutationFractal(probability, minF, maxF, justUsedNodes);
                 }
             },
@@ -394,7 +1342,7 @@ PYBIND11_MODULE(_core, m) {
             py::arg("justUsedNodes")=false
         )
 
-        .def("crossover", &Population::crossover,
+        .def("crossover", locked(&Population::crossover),
              py::call_guard<py::gil_scoped_release>(),
              py::arg("probability"), 
              py::arg("type"), 
@@ -416,6 +1364,7 @@ PYBIND11_MODULE(_core, m) {
 
                 {
                     py::gil_scoped_release release;
+                    auto lock = lock_idle_population(p);
                     p.callAddDelNodes(minF, maxF, junk, noElite);
                 }
             },
@@ -428,6 +1377,7 @@ PYBIND11_MODULE(_core, m) {
         // pickle support – serialise individuals as a plain Python list
         .def(py::pickle(
         [](const Population &p) { // __getstate__
+            auto lock = lock_population(p);
             py::list ind_list;
             for (const auto& net : p.individuals)
                 ind_list.append(py::cast(net));
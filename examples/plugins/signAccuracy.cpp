@@ -0,0 +1,48 @@
+// Example fitness plugin: fraction of rows on which the decision (0 = down,
+// 1 = up) matches the sign of the target (e.g. the next return).
+//
+// Build:  c++ -std=c++20 -O2 -shared -fPIC -I../../include signAccuracy.cpp -o signAccuracy.so
+// Use:    fracnetics.loadFitnessPlugin("./signAccuracy.so")
+//         pop.nativeFitness("signAccuracy", X, returns, dMax=10, worstFitness=0)
+#include "FitnessPlugin.h"
+
+namespace {
+
+struct State {
+    const float* targets;
+    size_t nRows;
+    size_t nCols;
+    size_t correct = 0;
+};
+
+void* create(void*, const float* targets, size_t nRows, size_t nCols){
+    return new State{targets, nRows, nCols};
+}
+
+void consume(void* state, size_t row, int32_t decision){
+    State* s = static_cast<State*>(state);
+    bool up = s->targets[row * s->nCols] > 0;
+    if((decision == 1) == up){
+        s->correct ++;
+    }
+}
+
+float finish(void* state){
+    State* s = static_cast<State*>(state);
+    return s->nRows == 0 ? 0 : static_cast<float>(s->correct) / s->nRows;
+}
+
+void destroy(void* state){
+    delete static_cast<State*>(state);
+}
+
+const FracneticsFitnessKernel kernels[] = {
+    {FRACNETICS_FITNESS_ABI_VERSION, "signAccuracy", nullptr, create, consume, finish, destroy}
+};
+
+}
+
+extern "C" const FracneticsFitnessKernel* fracnetics_fitness_kernels(size_t* count){
+    *count = sizeof(kernels) / sizeof(kernels[0]);
+    return kernels;
+}
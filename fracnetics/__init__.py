@@ -1,3 +1,3 @@
 from ._core import *  
 from .utilsModel import *
-
+from . import utilsAsync
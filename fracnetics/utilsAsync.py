@@ -0,0 +1,29 @@
+import asyncio
+from ._core import EvaluationHandle
+
+def awaitEvaluation(handle):
+    """
+    Make an EvaluationHandle awaitable from asyncio.
+
+    The blocking wait() runs in the default executor, so the event loop keeps
+    running while the population is evaluated. The function is installed as
+    EvaluationHandle.__await__, i.e. a handle can be awaited directly:
+
+        handle = pop.evaluateAsync("accuracy", X, y, dMax=10)
+        ...  # other work
+        await handle
+
+    Parameters
+    ----------
+    handle : EvaluationHandle
+        Handle returned by Population.evaluateAsync().
+
+    Returns
+    -------
+    iterator
+        Iterator of the awaitable that commits the evaluation.
+    """
+    loop = asyncio.get_running_loop()
+    return loop.run_in_executor(None, handle.wait).__await__()
+
+EvaluationHandle.__await__ = awaitEvaluation
@@ -0,0 +1,85 @@
+#ifndef AGGREGATION_HPP
+#define AGGREGATION_HPP
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @file Aggregation.hpp
+ * @brief Aggregation of several scores of one individual (series, folds, seeds) into a single fitness.
+ */
+
+/**
+ * @brief Checks an aggregation name before an evaluation starts.
+ * @param aggregation "mean", "worst" or "quantile"
+ * @param q quantile in [0, 1] (only checked for "quantile")
+ */
+inline void checkAggregation(const std::string& aggregation, float q = 0.5){
+    if(aggregation != "mean" && aggregation != "worst" && aggregation != "quantile"){
+        throw std::invalid_argument("unknown aggregation: " + aggregation + " (use mean, worst or quantile)");
+    }
+    if(aggregation == "quantile" && (q < 0 || q > 1)){
+        throw std::invalid_argument("quantile must be in [0, 1]");
+    }
+}
+
+/**
+ * @brief Aggregates scores into a single value.
+ *
+ * @details
+ * - **mean**: arithmetic mean
+ * - **worst**: minimum (robust selection: an individual is as good as its worst score)
+ * - **quantile**: q-quantile with linear interpolation (q = 0 equals worst, q = 0.5 the median)
+ *
+ * @param scores scores of one individual (copied, because the quantile sorts them)
+ * @param aggregation "mean", "worst" or "quantile"
+ * @param q quantile in [0, 1] (used by "quantile")
+ * @return aggregated score (0 for empty scores)
+ */
+inline float aggregateScores(std::vector<float> scores, const std::string& aggregation, float q = 0.5){
+    if(scores.empty()){
+        return 0;
+    }
+    if(aggregation == "mean"){
+        double sum = 0;
+        for(float s : scores){
+            sum += s;
+        }
+        return sum / scores.size();
+    } else if(aggregation == "worst"){
+        return *std::min_element(scores.begin(), scores.end());
+    } else if(aggregation == "quantile"){
+        std::sort(scores.begin(), scores.end());
+        double pos = q * (scores.size() - 1);
+        size_t lower = static_cast<size_t>(std::floor(pos));
+        size_t upper = std::min(lower + 1, scores.size() - 1);
+        double w = pos - lower;
+        return (1 - w) * scores[lower] + w * scores[upper];
+    }
+    throw std::invalid_argument("unknown aggregation: " + aggregation);
+}
+
+/**
+ * @brief Checks series offsets into a contiguous buffer of rows.
+ *
+ * @details
+ * Series s occupies the rows [offsets[s], offsets[s+1]). The offsets must start at 0,
+ * be non-decreasing and end at the number of rows.
+ *
+ * @param offsets series boundaries (number of series + 1 values)
+ * @param nRows number of rows of the buffer
+ */
+inline void checkSeriesOffsets(const std::vector<size_t>& offsets, size_t nRows){
+    if(offsets.size() < 2 || offsets.front() != 0 || offsets.back() != nRows){
+        throw std::invalid_argument("series offsets must start at 0 and end at the number of rows");
+    }
+    for(size_t s=1; s<offsets.size(); s++){
+        if(offsets[s] < offsets[s-1]){
+            throw std::invalid_argument("series offsets must be non-decreasing");
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,140 @@
+#ifndef ASYNCEVALUATION_HPP
+#define ASYNCEVALUATION_HPP
+#include <functional>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include "Population.hpp"
+
+/**
+ * @class EvaluationHandle
+ * @brief Handle of an evaluation that runs in the background (see evaluateAsync()).
+ *
+ * @details
+ * While the evaluation runs, the population is marked as evaluating; other operations
+ * on it must be rejected (see lockIdlePopulation(); the Python bindings raise an error)
+ * until wait() commits the results. If the handle is destroyed before wait() was called, the destructor waits
+ * for the evaluation and commits it, so the population never stays blocked.
+ */
+class EvaluationHandle {
+    public:
+        /**
+         * @param _population evaluated population (must outlive the handle)
+         * @param _future future of the background task
+         */
+        EvaluationHandle(Population& _population, std::future<void> _future):
+            population(&_population),
+            future(std::move(_future))
+        {}
+
+        EvaluationHandle(const EvaluationHandle&) = delete;
+        EvaluationHandle& operator=(const EvaluationHandle&) = delete;
+        EvaluationHandle(EvaluationHandle&& other) noexcept:
+            population(other.population),
+            future(std::move(other.future)),
+            committed(other.committed)
+        {
+            other.committed = true;
+        }
+
+        ~EvaluationHandle(){
+            try {
+                wait();
+            } catch(...) {
+                // an error is only reported to an explicit wait()
+            }
+        }
+
+        /** @brief True if the background task has finished (results are committed by wait()). */
+        bool done() const {
+            return committed || future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }
+
+        /**
+         * @brief Waits for the evaluation and commits it.
+         *
+         * @details
+         * Releases the population for other operations. Rethrows an exception of the
+         * evaluation. Calling wait() again is a no-op.
+         */
+        void wait(){
+            if(committed){
+                return;
+            }
+            committed = true;
+            future.wait();
+            {
+                std::lock_guard<std::mutex> lock(population->mutex.get());
+                population->evaluating = false;
+            }
+            future.get();
+        }
+
+    private:
+        Population* population;
+        std::future<void> future;
+        bool committed = false;
+};
+
+/**
+ * @brief Locks a population that is neither being evaluated nor borrowed.
+ *
+ * @details
+ * The background task of evaluateAsync() holds the mutex for the whole evaluation and
+ * a PopulationView keeps the individuals until it is released. The atomic flags are
+ * therefore checked before locking, so a conflicting call fails at once instead of
+ * waiting for the evaluation; they are checked again under the lock in case an
+ * evaluation started in between.
+ *
+ * @param population population to lock
+ * @return lock of the population's mutex
+ * @throws std::runtime_error if the population is being evaluated or borrowed
+ */
+inline std::unique_lock<std::mutex> lockIdlePopulation(const Population& population){
+    auto checkIdle = [&population](){
+        if(population.evaluating){
+            throw std::runtime_error("population is being evaluated asynchronously; call wait() first");
+        }
+        if(population.borrowed){
+            throw std::runtime_error("population is borrowed by a subset view; release() it first");
+        }
+    };
+    checkIdle();
+    std::unique_lock<std::mutex> lock(population.mutex.get());
+    checkIdle();
+    return lock;
+}
+
+/**
+ * @brief Starts an evaluation of a population on a background thread.
+ *
+ * @details
+ * The task runs under the lock of the population and may use the parallel evaluation
+ * engine (Population::nThreads). The task must own (copy) its data, because the caller
+ * continues while it runs.
+ *
+ * @param population population to evaluate
+ * @param task evaluation, e.g. [X, y](Population& p){ p.accuracy(X, y, 10, 0); }
+ * @return handle to wait for the evaluation
+ * @throws std::runtime_error if the population is already being evaluated or borrowed by a PopulationView
+ */
+inline EvaluationHandle evaluateAsync(Population& population, std::function<void(Population&)> task){
+    {
+        std::lock_guard<std::mutex> lock(population.mutex.get());
+        if(population.evaluating){
+            throw std::runtime_error("population is already being evaluated; call wait() first");
+        }
+        if(population.borrowed){
+            throw std::runtime_error("population is borrowed by a PopulationView; release it first");
+        }
+        population.evaluating = true;
+    }
+    Population* target = &population;
+    std::future<void> future = std::async(std::launch::async, [target, task = std::move(task)](){
+        std::lock_guard<std::mutex> lock(target->mutex.get());
+        task(*target);
+    });
+    return EvaluationHandle(population, std::move(future));
+}
+
+#endif
@@ -0,0 +1,175 @@
+#ifndef AUTOTUNER_HPP
+#define AUTOTUNER_HPP
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "Parallel.hpp"
+#include "Population.hpp"
+
+/**
+ * @struct ParallelSetting
+ * @brief One candidate configuration of the parallel evaluation engine.
+ */
+struct ParallelSetting {
+    unsigned int nThreads = 0; /**< Population::nThreads (0 = all hardware threads) */
+    size_t chunk = 1; /**< Population::chunk */
+};
+
+/**
+ * @struct AutotuneStats
+ * @brief Measurements of an Autotuner.
+ */
+struct AutotuneStats {
+    std::vector<ParallelSetting> candidates; /**< tried settings */
+    std::vector<double> seconds; /**< mean evaluation time per candidate (0 while unmeasured) */
+    std::vector<size_t> trials; /**< completed timings per candidate */
+    size_t best = 0; /**< index of the fastest candidate (valid once locked) */
+    bool locked = false; /**< true once all candidates are measured and the best is applied */
+    double speedup = 1; /**< time of the slowest candidate / time of the best one */
+};
+
+/**
+ * @class Autotuner
+ * @brief Times the first generations under candidate parallel settings and locks in the fastest.
+ *
+ * @details
+ * The best configuration differs between workloads: tiny data sets are dominated by
+ * thread start-up and want few threads or large chunks, long series or large
+ * populations want all threads. The tuner applies the candidates round-robin to the
+ * evaluations of the first generations (so that growing networks affect every candidate
+ * alike), and after trialsPerCandidate timings per candidate it sets the fastest one on
+ * the population for the rest of the run.
+ *
+ * Only the fitness evaluation is timed. Evaluation results do not depend on the
+ * setting, so tuning does not change the course of the evolution.
+ *
+ * @code
+ * Autotuner tuner(Autotuner::defaultCandidates(population.individuals.size()));
+ * for(int g=0; g<generations; g++){
+ *     tuner.evaluate(population, [&](Population& p){ p.accuracy(X, y, dMax, penalty); });
+ *     population.tournamentSelection(2, 1);
+ *     ...
+ * }
+ * @endcode
+ */
+class Autotuner {
+    public:
+        /**
+         * @brief Default candidates: 1, half and all hardware threads, each with chunk 1 and
+         *  with one chunk per thread and 4 rounds (n / (4 · threads)).
+         * @param n number of individuals
+         */
+        static std::vector<ParallelSetting> defaultCandidates(size_t n){
+            unsigned int all = resolveThreads(0);
+            std::vector<unsigned int> threads = {1};
+            if(all >= 4){
+                threads.push_back(all / 2);
+            }
+            if(all >= 2){
+                threads.push_back(all);
+            }
+            std::vector<ParallelSetting> candidates;
+            for(unsigned int t : threads){
+                candidates.push_back({t, 1});
+                size_t coarse = std::max<size_t>(1, n / (4 * t));
+                if(t > 1 && coarse > 1){
+                    candidates.push_back({t, coarse});
+                }
+            }
+            return candidates;
+        }
+
+        /**
+         * @param candidates settings to try (at least one)
+         * @param _trialsPerCandidate timings per candidate before the best is locked in
+         */
+        explicit Autotuner(std::vector<ParallelSetting> candidates, size_t _trialsPerCandidate = 1):
+            trialsPerCandidate(_trialsPerCandidate)
+        {
+            if(candidates.empty() || trialsPerCandidate == 0){
+                throw std::invalid_argument("an autotuner needs at least one candidate and one trial");
+            }
+            measured.candidates = std::move(candidates);
+            measured.seconds.assign(measured.candidates.size(), 0);
+            measured.trials.assign(measured.candidates.size(), 0);
+            totals.assign(measured.candidates.size(), 0);
+        }
+
+        /**
+         * @brief Applies the setting of the next timing to the population and starts the clock.
+         * @details Once locked, the best setting is applied and nothing is timed.
+         */
+        void begin(Population& population){
+            const ParallelSetting& setting = measured.candidates[measured.locked ? measured.best : current];
+            population.nThreads = setting.nThreads;
+            population.chunk = setting.chunk;
+            started = std::chrono::steady_clock::now();
+            running = true;
+        }
+
+        /**
+         * @brief Stops the clock, records the timing and locks in the best setting when all
+         *  candidates are measured.
+         * @param population population passed to begin() (receives the best setting)
+         */
+        void end(Population& population){
+            if(!running){
+                throw std::runtime_error("Autotuner::end() without begin()");
+            }
+            running = false;
+            if(measured.locked){
+                return;
+            }
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - started;
+            totals[current] += elapsed.count();
+            measured.trials[current]++;
+            measured.seconds[current] = totals[current] / measured.trials[current];
+            current = (current + 1) % measured.candidates.size();
+            if(current == 0 && measured.trials.back() >= trialsPerCandidate){
+                lock(population);
+            }
+        }
+
+        /**
+         * @brief Times one evaluation: begin(), evaluate(population), end().
+         * @tparam Evaluate callable with signature void(Population&)
+         */
+        template <typename Evaluate>
+        void evaluate(Population& population, Evaluate&& evaluate){
+            begin(population);
+            try {
+                evaluate(population);
+            } catch(...) {
+                running = false;
+                throw;
+            }
+            end(population);
+        }
+
+        bool locked() const { return measured.locked; } /**< true once the best setting is fixed */
+        const ParallelSetting& best() const { return measured.candidates[measured.best]; } /**< fastest setting (valid once locked) */
+        const AutotuneStats& stats() const { return measured; } /**< measurements so far */
+
+        const size_t trialsPerCandidate; /**< timings per candidate before locking */
+
+    private:
+        AutotuneStats measured;
+        std::vector<double> totals;
+        size_t current = 0;
+        bool running = false;
+        std::chrono::steady_clock::time_point started;
+
+        void lock(Population& population){
+            auto fastest = std::min_element(measured.seconds.begin(), measured.seconds.end());
+            double slowest = *std::max_element(measured.seconds.begin(), measured.seconds.end());
+            measured.best = fastest - measured.seconds.begin();
+            measured.speedup = *fastest > 0 ? slowest / *fastest : 1;
+            measured.locked = true;
+            population.nThreads = best().nThreads;
+            population.chunk = best().chunk;
+        }
+};
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef BACKTEST_HPP
+#define BACKTEST_HPP
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @class BacktestAccumulator
+ * @brief Streaming accumulator for the profit and loss of a trading rule.
+ *
+ * @details
+ * The accumulator consumes one position per row and computes all statistics on
+ * the fly, so no buffer of decisions or returns is needed. Per row t:
+ *
+ * - pnl[t] = position[t] × return[t] − cost × |position[t] − position[t-1]|
+ * - equity is the cumulative sum of pnl (additive returns), starting flat (position 0)
+ *
+ * The statistics are:
+ * - **netReturn**: sum of pnl (turnover-adjusted by the transaction costs)
+ * - **sharpe**: mean(pnl) / std(pnl) × sqrt(periodsPerYear) (0 for constant pnl)
+ * - **maxDrawdown**: largest drop of the equity curve from its running peak (≥ 0)
+ * - **turnover**: sum of |position[t] − position[t-1]|
+ */
+class BacktestAccumulator {
+    public:
+        /**
+         * @param _cost transaction cost per unit of turnover (e.g. 0.001 = 10 basis points)
+         */
+        explicit BacktestAccumulator(float _cost = 0):
+            cost(_cost)
+        {}
+
+        /**
+         * @brief Adds one row.
+         * @param position position held over the row (e.g. -1 short, 0 flat, 1 long)
+         * @param ret return of the asset over the row
+         */
+        void update(double position, double ret){
+            double change = std::abs(position - lastPosition);
+            double pnl = position * ret - cost * change;
+            lastPosition = position;
+            turnover += change;
+            sum += pnl;
+            n ++;
+            double delta = pnl - mean; // Welford update of mean and variance
+            mean += delta / n;
+            m2 += delta * (pnl - mean);
+            peak = std::max(peak, sum);
+            maxDrawdown = std::max(maxDrawdown, peak - sum);
+        }
+
+        double netReturn() const { return sum; } /**< sum of pnl after costs */
+        double getTurnover() const { return turnover; } /**< sum of absolute position changes */
+        double getMaxDrawdown() const { return maxDrawdown; } /**< largest drawdown of the equity curve */
+
+        /**
+         * @brief annualised Sharpe ratio of the pnl series.
+         * @param periodsPerYear number of rows per year (e.g. 252 for daily bars)
+         */
+        double sharpe(double periodsPerYear) const {
+            if(n < 2){
+                return 0;
+            }
+            double var = m2 / n;
+            if(var <= 0){
+                return 0;
+            }
+            return mean / std::sqrt(var) * std::sqrt(periodsPerYear);
+        }
+
+        /**
+         * @brief fitness value of the backtest.
+         * @param metric "return" (net return), "sharpe" (annualised Sharpe ratio) or
+         *  "calmar" (net return / max drawdown; net return if there is no drawdown)
+         * @param periodsPerYear number of rows per year (used by "sharpe")
+         */
+        double score(const std::string& metric, double periodsPerYear) const {
+            if(metric == "return"){
+                return netReturn();
+            } else if(metric == "sharpe"){
+                return sharpe(periodsPerYear);
+            } else if(metric == "calmar"){
+                return maxDrawdown > 0 ? netReturn() / maxDrawdown : netReturn();
+            }
+            throw std::invalid_argument("unknown backtest metric: " + metric);
+        }
+
+        /**
+         * @brief checks a metric name before an evaluation starts.
+         */
+        static void checkMetric(const std::string& metric){
+            if(metric != "return" && metric != "sharpe" && metric != "calmar"){
+                throw std::invalid_argument("unknown backtest metric: " + metric + " (use return, sharpe or calmar)");
+            }
+        }
+
+    private:
+        double cost;
+        double lastPosition = 0;
+        double sum = 0;
+        double mean = 0;
+        double m2 = 0;
+        double turnover = 0;
+        double peak = 0;
+        double maxDrawdown = 0;
+        size_t n = 0;
+};
+
+#endif
@@ -0,0 +1,219 @@
+#ifndef BEHAVIORARCHIVE_HPP
+#define BEHAVIORARCHIVE_HPP
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include "Hash.hpp"
+
+/**
+ * @class BehaviorArchive
+ * @brief Archive of behaviour signatures with an LSH index for approximate k-NN novelty.
+ *
+ * @details
+ * Novelty search rewards individuals that behave differently from everything seen
+ * before. Comparing raw decision vectors against the archive costs O(N·A·L) per
+ * generation; the archive therefore stores compact SimHash signatures:
+ *
+ * - A behaviour descriptor is a sequence of integers: the decisions of a network on a
+ *   data set, or a trajectory / final observation quantised with quantise().
+ * - signature() hashes every (position, value) pair to 64·nWords pseudo-random ±1 bits
+ *   and keeps the sign of the sums (SimHash). The Hamming distance of two signatures
+ *   estimates the angle between the one-hot encoded descriptors, so networks that agree
+ *   on most positions get close signatures.
+ * - The signature is split into nBands bands; each band is a key of a hash table
+ *   (locality-sensitive hashing). A query only compares signatures that share at least
+ *   one band with it.
+ *
+ * novelty() is the mean normalised Hamming distance (0 = identical, 0.5 = unrelated) to
+ * the k nearest candidates. Missing neighbours (fewer than k candidates) count as
+ * unrelated (0.5), so behaviour in a sparsely covered region is rated as novel.
+ * The archive has a fixed capacity; new signatures replace the oldest ones.
+ *
+ * @see Population::noveltyObjective()
+ */
+class BehaviorArchive {
+    public:
+        using Signature = std::vector<uint64_t>; /**< bit-packed SimHash signature */
+
+        /**
+         * @param _nWords signature length in 64-bit words
+         * @param _nBands number of LSH bands (must divide 64·nWords; more bands find more candidates)
+         * @param _k number of neighbours of a novelty query
+         * @param _capacity maximum number of stored signatures
+         * @param _seed seed of the hash functions
+         * @throws std::invalid_argument for invalid sizes
+         */
+        explicit BehaviorArchive(
+                size_t _nWords = 1,
+                size_t _nBands = 8,
+                size_t _k = 15,
+                size_t _capacity = 10000,
+                uint64_t _seed = 0
+                ):
+            nWords(_nWords),
+            nBands(_nBands),
+            k(_k),
+            capacity(_capacity),
+            seed(_seed),
+            tables(_nBands)
+        {
+            if(nWords == 0 || nBands == 0 || (64 * nWords) % nBands != 0 || (64 * nWords) / nBands > 64){
+                throw std::invalid_argument("nBands must divide the 64 * nWords signature bits into bands of at most 64 bits");
+            }
+            if(k == 0 || capacity == 0){
+                throw std::invalid_argument("a behavior archive needs k >= 1 and capacity >= 1");
+            }
+        }
+
+        /**
+         * @brief Quantises a continuous descriptor (e.g. a trajectory) to integers.
+         * @param values descriptor
+         * @param quantum bucket width (> 0)
+         */
+        static std::vector<int> quantise(const std::vector<float>& values, float quantum){
+            if(!(quantum > 0)){
+                throw std::invalid_argument("quantum must be > 0");
+            }
+            std::vector<int> codes(values.size());
+            for(size_t i=0; i<values.size(); i++){
+                codes[i] = static_cast<int>(std::floor(values[i] / quantum));
+            }
+            return codes;
+        }
+
+        /** @brief SimHash signature of a descriptor. */
+        Signature signature(const std::vector<int>& descriptor) const {
+            size_t nBits = 64 * nWords;
+            std::vector<int> counts(nBits, 0);
+            for(size_t i=0; i<descriptor.size(); i++){
+                uint64_t h = splitmix64(seed ^ splitmix64(i + 1) ^ (static_cast<uint64_t>(static_cast<uint32_t>(descriptor[i])) << 17));
+                for(size_t w=0; w<nWords; w++){
+                    uint64_t bits = splitmix64(h + w);
+                    for(size_t b=0; b<64; b++){
+                        counts[w * 64 + b] += (bits >> b) & 1 ? 1 : -1;
+                    }
+                }
+            }
+            Signature s(nWords, 0);
+            for(size_t b=0; b<nBits; b++){
+                if(counts[b] > 0){
+                    s[b / 64] |= uint64_t(1) << (b % 64);
+                }
+            }
+            return s;
+        }
+
+        /**
+         * @brief Normalised Hamming distance of two signatures, in [0, 1].
+         */
+        static float distance(const Signature& a, const Signature& b){
+            size_t d = 0;
+            for(size_t w=0; w<a.size(); w++){
+                d += std::popcount(a[w] ^ b[w]);
+            }
+            return static_cast<float>(d) / (64 * a.size());
+        }
+
+        /**
+         * @brief Approximate novelty of a signature with respect to the archive.
+         * @return mean distance to the k nearest LSH candidates (missing neighbours count 0.5)
+         */
+        float novelty(const Signature& s) const {
+            checkSignature(s);
+            std::vector<size_t> candidates;
+            for(size_t band=0; band<nBands; band++){
+                auto it = tables[band].find(bandKey(s, band));
+                if(it != tables[band].end()){
+                    candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+                }
+            }
+            std::sort(candidates.begin(), candidates.end());
+            candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+            std::vector<float> distances;
+            distances.reserve(candidates.size());
+            for(size_t c : candidates){
+                distances.push_back(distance(s, signatures[c]));
+            }
+            size_t kk = std::min(k, distances.size());
+            std::partial_sort(distances.begin(), distances.begin() + kk, distances.end());
+            double sum = 0;
+            for(size_t i=0; i<kk; i++){
+                sum += distances[i];
+            }
+            sum += 0.5 * (k - kk);
+            return sum / k;
+        }
+
+        /**
+         * @brief Stores a signature (replaces the oldest one if the archive is full).
+         */
+        void add(const Signature& s){
+            checkSignature(s);
+            size_t slot;
+            if(signatures.size() < capacity){
+                slot = signatures.size();
+                signatures.push_back(s);
+            } else {
+                slot = head;
+                head = (head + 1) % capacity;
+                for(size_t band=0; band<nBands; band++){
+                    auto it = tables[band].find(bandKey(signatures[slot], band));
+                    auto& bucket = it->second;
+                    bucket.erase(std::find(bucket.begin(), bucket.end(), slot));
+                    if(bucket.empty()){
+                        tables[band].erase(it);
+                    }
+                }
+                signatures[slot] = s;
+            }
+            for(size_t band=0; band<nBands; band++){
+                tables[band][bandKey(s, band)].push_back(slot);
+            }
+        }
+
+        /** @brief Removes all signatures. */
+        void clear(){
+            signatures.clear();
+            for(auto& table : tables){
+                table.clear();
+            }
+            head = 0;
+        }
+
+        size_t size() const { return signatures.size(); } /**< number of stored signatures */
+        const std::vector<Signature>& entries() const { return signatures; } /**< stored signatures (slot order) */
+
+        const size_t nWords; /**< signature length in 64-bit words */
+        const size_t nBands; /**< number of LSH bands */
+        size_t k; /**< number of neighbours of a novelty query */
+        const size_t capacity; /**< maximum number of stored signatures */
+
+    private:
+        uint64_t seed;
+        std::vector<Signature> signatures;
+        std::vector<std::unordered_map<uint64_t, std::vector<size_t>>> tables; // one per band
+        size_t head = 0; // oldest signature once the archive is full
+
+        void checkSignature(const Signature& s) const {
+            if(s.size() != nWords){
+                throw std::invalid_argument("signature length does not match the archive");
+            }
+        }
+
+        uint64_t bandKey(const Signature& s, size_t band) const {
+            size_t width = 64 * nWords / nBands;
+            size_t first = band * width;
+            uint64_t key = 0;
+            for(size_t b=0; b<width; b++){
+                size_t bit = first + b;
+                key |= ((s[bit / 64] >> (bit % 64)) & 1) << b;
+            }
+            return key;
+        }
+};
+
+#endif
@@ -1,4 +1,7 @@
+#ifndef CARTPOLE_HPP
+#define CARTPOLE_HPP
 #include <cmath>
+#include <memory>
 #include <random>
 #include <iostream>
 #include <array>
@@ -158,3 +161,4 @@ public:
     }
 };
 
+#endif
@@ -0,0 +1,325 @@
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "GenomeView.hpp"
+#include "Population.hpp"
+
+/**
+ * @file Checkpoint.hpp
+ * @brief Saving and restoring the state of an evolutionary run.
+ *
+ * @details
+ * A checkpoint is a line-based text file that stores everything needed to continue
+ * a run with the same random stream:
+ *
+ * @code
+ * fracnetics-checkpoint 4
+ * generation <g>
+ * population <ni> <jnf> <pnf>
+ * generator <state of std::mt19937_64>
+ * statistics <bestFit> <meanFitness> <minFitness>
+ * elite <n> <index> ...
+ * seedpool <maxSeed> <nAnchors> <anchor> ... <nRolling> <seed> ...
+ * individual <fitness> <nBest> <nInnerNodes> <startEdge> <jn> <pn>   (ni times)
+ * history <capacity> <n> <return> ...                          (oldest return first)
+ * node <J|P> <f> <k> <d> <nEdges> <edge> ... <nBoundaries> <boundary> ... <nParameters> <parameter> ...
+ * @endcode
+ *
+ * jn and pn are the node counters of the network: Network::pnRatio() accumulates into
+ * them and addDelNodes() draws from the ratio, so a resumed run only follows the same
+ * random stream if they are restored as well.
+ *
+ * Version 1 files (without history records), version 2 files (without jn and pn) and
+ * version 3 files (without the seed pool) can still be read; their jn and pn are set to
+ * the node counts and the seed pool of the population is kept.
+ *
+ * Floating-point values are written with full precision, so a restored population
+ * evaluates exactly like the saved one.
+ */
+
+/** version of the checkpoint format written by saveCheckpoint() */
+inline constexpr int FRACNETICS_CHECKPOINT_VERSION = 4;
+
+/**
+ * @brief Writes a checkpoint of a population.
+ *
+ * @details
+ * The file is first written to path + ".tmp" and then renamed, so an interrupted
+ * job never leaves a truncated checkpoint behind.
+ *
+ * @param population population to save
+ * @param generation number of completed generations
+ * @param path file to write
+ * @throws std::runtime_error if the file cannot be written
+ */
+inline void saveCheckpoint(const Population& population, int generation, const std::string& path){
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath);
+        if(!out){
+            throw std::runtime_error("cannot write checkpoint " + tmpPath);
+        }
+        out.precision(std::numeric_limits<double>::max_digits10);
+        out << "fracnetics-checkpoint " << FRACNETICS_CHECKPOINT_VERSION << "\n";
+        out << "generation " << generation << "\n";
+        out << "population " << population.ni << " " << population.jnf << " " << population.pnf << "\n";
+        out << "generator " << population.generatorState() << "\n";
+        out << "statistics " << population.bestFit << " " << population.meanFitness << " " << population.minFitness << "\n";
+        out << "elite " << population.indicesElite.size();
+        for(int i : population.indicesElite){
+            out << " " << i;
+        }
+        out << "\n";
+        const SeedPool& pool = population.seedPool;
+        out << "seedpool " << pool.maxSeed << " " << pool.anchors.size();
+        for(int seed : pool.anchors){
+            out << " " << seed;
+        }
+        out << " " << pool.rolling.size();
+        for(int seed : pool.rolling){
+            out << " " << seed;
+        }
+        out << "\n";
+        for(const Network& network : population.individuals){
+            out << "individual " << network.fitness << " " << network.nBest << " "
+                << network.innerNodes.size() << " " << network.startNode.edges[0] << " "
+                << network.jn << " " << network.pn << "\n";
+            out << "history " << network.seedHistory.capacity() << " " << network.seedHistory.size();
+            for(float v : network.seedHistory.toVector()){
+                out << " " << v;
+            }
+            out << "\n";
+            for(const Node& node : network.innerNodes){
+                out << "node " << node.type << " " << node.f << " " << node.k_d.first << " " << node.k_d.second;
+                out << " " << node.edges.size();
+                for(int e : node.edges){
+                    out << " " << e;
+                }
+                out << " " << node.boundaries.size();
+                for(double b : node.boundaries){
+                    out << " " << b;
+                }
+                out << " " << node.productionRuleParameter.size();
+                for(float p : node.productionRuleParameter){
+                    out << " " << p;
+                }
+                out << "\n";
+            }
+        }
+        if(!out.flush()){
+            throw std::runtime_error("cannot write checkpoint " + tmpPath);
+        }
+    }
+    if(std::rename(tmpPath.c_str(), path.c_str()) != 0){
+        throw std::runtime_error("cannot move checkpoint to " + path);
+    }
+}
+
+/** @cond INTERNAL */
+namespace checkpoint_detail {
+
+// reads the next line and checks its keyword
+inline std::istringstream nextRecord(std::istream& in, const std::string& keyword, const std::string& path){
+    std::string line;
+    if(!std::getline(in, line)){
+        throw std::runtime_error("checkpoint " + path + " ends before the '" + keyword + "' record");
+    }
+    std::istringstream record(line);
+    std::string found;
+    if(!(record >> found) || found != keyword){
+        throw std::runtime_error("checkpoint " + path + ": expected '" + keyword + "' record");
+    }
+    return record;
+}
+
+template <typename T>
+T readValue(std::istream& record, const std::string& keyword, const std::string& path){
+    T value;
+    if constexpr(std::is_floating_point_v<T>){
+        // operator>> rejects nan, inf and subnormal values, which a run can produce
+        std::string token;
+        char* end = nullptr;
+        if(record >> token){
+            value = static_cast<T>(std::strtod(token.c_str(), &end));
+        }
+        if(end == nullptr || *end != '\0'){
+            throw std::runtime_error("checkpoint " + path + ": malformed '" + keyword + "' record");
+        }
+    } else if(!(record >> value)){
+        throw std::runtime_error("checkpoint " + path + ": malformed '" + keyword + "' record");
+    }
+    return value;
+}
+
+}
+/** @endcond */
+
+/**
+ * @brief Restores a population from a checkpoint.
+ *
+ * @details
+ * The population must have been constructed with the same number of individuals and
+ * node functions as the saved one. Genomes, node counters, fitness values, return
+ * histories, elite indices, statistics, the seed pool and the random generator are
+ * restored; every genome is validated (see GenomeView::validate()) before it is written.
+ *
+ * @param population population to overwrite
+ * @param path checkpoint file
+ * @return number of completed generations stored in the checkpoint
+ * @throws std::runtime_error if the file cannot be read or does not match the population
+ * @throws std::invalid_argument if a stored genome is invalid
+ */
+inline int loadCheckpoint(Population& population, const std::string& path){
+    using namespace checkpoint_detail;
+    std::ifstream in(path);
+    if(!in){
+        throw std::runtime_error("cannot read checkpoint " + path);
+    }
+    auto header = nextRecord(in, "fracnetics-checkpoint", path);
+    int version = readValue<int>(header, "fracnetics-checkpoint", path);
+    if(version < 1 || version > FRACNETICS_CHECKPOINT_VERSION){
+        throw std::runtime_error("checkpoint " + path + " has an unsupported version");
+    }
+    auto generationRecord = nextRecord(in, "generation", path);
+    int generation = readValue<int>(generationRecord, "generation", path);
+
+    auto populationRecord = nextRecord(in, "population", path);
+    unsigned int ni = readValue<unsigned int>(populationRecord, "population", path);
+    unsigned int jnf = readValue<unsigned int>(populationRecord, "population", path);
+    unsigned int pnf = readValue<unsigned int>(populationRecord, "population", path);
+    if(ni != population.ni || jnf != population.jnf || pnf != population.pnf){
+        throw std::runtime_error("checkpoint " + path + " was written for a population with other ni, jnf or pnf");
+    }
+
+    auto generatorRecord = nextRecord(in, "generator", path);
+    std::string state;
+    std::getline(generatorRecord >> std::ws, state);
+
+    auto statistics = nextRecord(in, "statistics", path);
+    float bestFit = readValue<float>(statistics, "statistics", path);
+    float meanFitness = readValue<float>(statistics, "statistics", path);
+    float minFitness = readValue<float>(statistics, "statistics", path);
+
+    auto eliteRecord = nextRecord(in, "elite", path);
+    std::vector<int> indicesElite(readValue<size_t>(eliteRecord, "elite", path));
+    for(int& i : indicesElite){
+        i = readValue<int>(eliteRecord, "elite", path);
+        if(i < 0 || static_cast<unsigned int>(i) >= ni){
+            throw std::runtime_error("checkpoint " + path + ": elite index out of range");
+        }
+    }
+
+    SeedPool seedPool = population.seedPool;
+    if(version >= 4){
+        auto poolRecord = nextRecord(in, "seedpool", path);
+        seedPool.maxSeed = readValue<int>(poolRecord, "seedpool", path);
+        if(seedPool.maxSeed < 0){
+            throw std::runtime_error("checkpoint " + path + ": malformed 'seedpool' record");
+        }
+        seedPool.anchors.assign(readValue<size_t>(poolRecord, "seedpool", path), 0);
+        for(int& seed : seedPool.anchors){
+            seed = readValue<int>(poolRecord, "seedpool", path);
+        }
+        seedPool.rolling.assign(readValue<size_t>(poolRecord, "seedpool", path), 0);
+        for(int& seed : seedPool.rolling){
+            seed = readValue<int>(poolRecord, "seedpool", path);
+        }
+    }
+
+    // parse everything before the population is modified
+    struct Individual {
+        float fitness;
+        int nBest;
+        unsigned int jn = 0; // stored from version 3 on
+        unsigned int pn = 0;
+        GenomeView genome;
+        SeedHistory history;
+        std::vector<std::pair<int, int>> k_d;
+        std::vector<std::vector<float>> parameters;
+    };
+    std::vector<Individual> restored(ni);
+    for(Individual& individual : restored){
+        auto record = nextRecord(in, "individual", path);
+        individual.fitness = readValue<float>(record, "individual", path);
+        individual.nBest = readValue<int>(record, "individual", path);
+        size_t nNodes = readValue<size_t>(record, "individual", path);
+        individual.genome.startEdge = readValue<int32_t>(record, "individual", path);
+        if(version >= 3){
+            individual.jn = readValue<unsigned int>(record, "individual", path);
+            individual.pn = readValue<unsigned int>(record, "individual", path);
+        }
+        if(version >= 2){
+            auto history = nextRecord(in, "history", path);
+            individual.history.setCapacity(readValue<size_t>(history, "history", path));
+            size_t nValues = readValue<size_t>(history, "history", path);
+            for(size_t v=0; v<nValues; v++){
+                individual.history.push(readValue<float>(history, "history", path));
+            }
+        }
+        GenomeView& genome = individual.genome;
+        genome.edgeOffsets.push_back(0);
+        genome.boundaryOffsets.push_back(0);
+        for(size_t n=0; n<nNodes; n++){
+            auto node = nextRecord(in, "node", path);
+            std::string type = readValue<std::string>(node, "node", path);
+            genome.types.push_back(static_cast<uint8_t>(type[0]));
+            genome.functions.push_back(readValue<int32_t>(node, "node", path));
+            int k = readValue<int>(node, "node", path);
+            int d = readValue<int>(node, "node", path);
+            individual.k_d.emplace_back(k, d);
+            size_t nEdges = readValue<size_t>(node, "node", path);
+            for(size_t e=0; e<nEdges; e++){
+                genome.edgeTargets.push_back(readValue<int32_t>(node, "node", path));
+            }
+            size_t nBoundaries = readValue<size_t>(node, "node", path);
+            for(size_t b=0; b<nBoundaries; b++){
+                genome.boundaryValues.push_back(readValue<double>(node, "node", path));
+            }
+            size_t nParameters = readValue<size_t>(node, "node", path);
+            std::vector<float> parameters(nParameters);
+            for(float& p : parameters){
+                p = readValue<float>(node, "node", path);
+            }
+            individual.parameters.push_back(std::move(parameters));
+            genome.edgeOffsets.push_back(genome.edgeTargets.size());
+            genome.boundaryOffsets.push_back(genome.boundaryValues.size());
+        }
+        genome.validate(jnf, pnf);
+    }
+
+    population.setGeneratorState(state);
+    for(size_t i=0; i<ni; i++){
+        Network& network = population.individuals[i];
+        restored[i].genome.applyTo(network);
+        for(size_t n=0; n<network.innerNodes.size(); n++){
+            network.innerNodes[n].k_d = restored[i].k_d[n];
+            network.innerNodes[n].productionRuleParameter = std::move(restored[i].parameters[n]);
+        }
+        network.fitness = restored[i].fitness;
+        network.nBest = restored[i].nBest;
+        if(version >= 3){ // applyTo() set them to the node counts
+            network.jn = restored[i].jn;
+            network.pn = restored[i].pn;
+        }
+        if(version >= 2){
+            network.seedHistory = restored[i].history;
+        }
+        network.invalid = false;
+    }
+    population.bestFit = bestFit;
+    population.meanFitness = meanFitness;
+    population.minFitness = minFitness;
+    population.indicesElite = indicesElite;
+    population.seedPool = seedPool;
+    return generation;
+}
+
+#endif
@@ -0,0 +1,193 @@
+#ifndef CONFIG_HPP
+#define CONFIG_HPP
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @class Config
+ * @brief Minimal INI configuration for native training jobs.
+ *
+ * @details
+ * Lines have the form `key = value` below a `[section]` header; values are addressed
+ * as "section.key". Lines starting with '#' or ';' are comments, and whitespace around
+ * keys and values is ignored. Lists are comma-separated (see getList()).
+ *
+ * @code
+ * [population]
+ * individuals = 500   # keys before the first section have no prefix
+ * @endcode
+ *
+ * Typed getters throw std::invalid_argument naming the key if a value cannot be parsed,
+ * so a typo in a batch job fails before the run starts.
+ */
+class Config {
+    public:
+        /**
+         * @brief Parses INI text.
+         * @param text content of the configuration
+         * @param source name used in error messages (e.g. the file name)
+         * @throws std::invalid_argument for lines that are neither sections nor key/value pairs
+         */
+        static Config fromString(const std::string& text, const std::string& source = "config"){
+            Config config;
+            std::istringstream in(text);
+            std::string line;
+            std::string section;
+            size_t lineNumber = 0;
+            while(std::getline(in, line)){
+                lineNumber ++;
+                std::string content = trim(stripComment(line));
+                if(content.empty()){
+                    continue;
+                }
+                if(content.front() == '['){
+                    if(content.back() != ']'){
+                        throw std::invalid_argument(source + ":" + std::to_string(lineNumber) + ": unterminated section header");
+                    }
+                    section = trim(content.substr(1, content.size()-2));
+                    continue;
+                }
+                size_t eq = content.find('=');
+                if(eq == std::string::npos || trim(content.substr(0, eq)).empty()){
+                    throw std::invalid_argument(source + ":" + std::to_string(lineNumber) + ": expected 'key = value'");
+                }
+                std::string key = trim(content.substr(0, eq));
+                config.set(section.empty() ? key : section + "." + key, trim(content.substr(eq+1)));
+            }
+            return config;
+        }
+
+        /**
+         * @brief Reads an INI file.
+         * @throws std::runtime_error if the file cannot be opened
+         */
+        static Config fromFile(const std::string& path){
+            std::ifstream file(path);
+            if(!file){
+                throw std::runtime_error("cannot read config file " + path);
+            }
+            std::stringstream text;
+            text << file.rdbuf();
+            return fromString(text.str(), path);
+        }
+
+        /**
+         * @brief Sets or overrides a value (e.g. from the command line).
+         * @param key "section.key"
+         * @param value raw value
+         */
+        void set(const std::string& key, const std::string& value){
+            values[key] = value;
+        }
+
+        /** @brief True if the key is set. */
+        bool has(const std::string& key) const {
+            return values.count(key) > 0;
+        }
+
+        /**
+         * @brief Value of a key converted to T (std::string, bool or a number).
+         * @param key "section.key"
+         * @param fallback value returned if the key is not set
+         */
+        template <typename T>
+        T get(const std::string& key, const T& fallback) const {
+            auto it = values.find(key);
+            if(it == values.end()){
+                return fallback;
+            }
+            return convert<T>(key, it->second);
+        }
+
+        /**
+         * @brief Value of a key that must be set.
+         * @throws std::invalid_argument if the key is missing
+         */
+        template <typename T>
+        T require(const std::string& key) const {
+            auto it = values.find(key);
+            if(it == values.end()){
+                throw std::invalid_argument("missing config value " + key);
+            }
+            return convert<T>(key, it->second);
+        }
+
+        /**
+         * @brief Comma-separated list of values (empty if the key is not set).
+         */
+        template <typename T>
+        std::vector<T> getList(const std::string& key) const {
+            std::vector<T> result;
+            auto it = values.find(key);
+            if(it == values.end()){
+                return result;
+            }
+            std::stringstream in(it->second);
+            std::string item;
+            while(std::getline(in, item, ',')){
+                item = trim(item);
+                if(!item.empty()){
+                    result.push_back(convert<T>(key, item));
+                }
+            }
+            return result;
+        }
+
+        /** @brief All keys in alphabetical order. */
+        std::vector<std::string> keys() const {
+            std::vector<std::string> result;
+            for(const auto& entry : values){
+                result.push_back(entry.first);
+            }
+            return result;
+        }
+
+    private:
+        std::map<std::string, std::string> values;
+
+        template <typename T>
+        static T convert(const std::string& key, const std::string& raw){
+            if constexpr (std::is_same_v<T, std::string>){
+                return raw;
+            } else if constexpr (std::is_same_v<T, bool>){
+                if(raw == "true" || raw == "yes" || raw == "on" || raw == "1"){
+                    return true;
+                }
+                if(raw == "false" || raw == "no" || raw == "off" || raw == "0"){
+                    return false;
+                }
+                throw std::invalid_argument("config value " + key + " must be true or false, got '" + raw + "'");
+            } else {
+                std::istringstream in(raw);
+                T value;
+                if(!(in >> value) || !(in >> std::ws).eof()){
+                    throw std::invalid_argument("config value " + key + " is not a number: '" + raw + "'");
+                }
+                return value;
+            }
+        }
+
+        static std::string stripComment(const std::string& line){
+            size_t first = line.find_first_not_of(" \t");
+            if(first != std::string::npos && (line[first] == '#' || line[first] == ';')){
+                return "";
+            }
+            size_t hash = line.find(" #");
+            return hash == std::string::npos ? line : line.substr(0, hash);
+        }
+
+        static std::string trim(const std::string& s){
+            size_t first = s.find_first_not_of(" \t\r");
+            if(first == std::string::npos){
+                return "";
+            }
+            size_t last = s.find_last_not_of(" \t\r");
+            return s.substr(first, last - first + 1);
+        }
+};
+
+#endif
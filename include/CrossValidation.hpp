@@ -0,0 +1,138 @@
+#ifndef CROSSVALIDATION_HPP
+#define CROSSVALIDATION_HPP
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @file CrossValidation.hpp
+ * @brief Fold index sets for k-fold and walk-forward cross-validation.
+ *
+ * @details
+ * A fold only stores row indices into the shared data set, so evaluating many folds
+ * never copies rows. The indices of a part are in ascending order, which keeps the
+ * time order of the rows for the stateful traversal of a network.
+ *
+ * @see Population::crossValidationAccuracy()
+ */
+
+/**
+ * @struct Fold
+ * @brief Row indices of the training and the test part of one fold.
+ */
+struct Fold {
+    std::vector<size_t> train; /**< ascending row indices of the training part */
+    std::vector<size_t> test; /**< ascending row indices of the test part */
+
+    /**
+     * @brief Returns the part selected by name.
+     * @param part "train" or "test"
+     */
+    const std::vector<size_t>& rows(const std::string& part) const {
+        if(part == "train"){
+            return train;
+        } else if(part == "test"){
+            return test;
+        }
+        throw std::invalid_argument("unknown fold part: " + part + " (use train or test)");
+    }
+};
+
+/**
+ * @brief Splits nRows rows into k contiguous folds.
+ *
+ * @details
+ * Fold i tests on the i-th contiguous block of rows and trains on all other rows.
+ * The first nRows % k blocks are one row longer.
+ *
+ * @param nRows number of rows of the data set
+ * @param k number of folds (2 ≤ k ≤ nRows)
+ */
+inline std::vector<Fold> kFoldSplits(size_t nRows, size_t k){
+    if(k < 2 || k > nRows){
+        throw std::invalid_argument("k-fold needs 2 <= k <= number of rows");
+    }
+    std::vector<Fold> folds(k);
+    size_t begin = 0;
+    for(size_t i=0; i<k; i++){
+        size_t end = begin + nRows / k + (i < nRows % k ? 1 : 0);
+        for(size_t r=0; r<nRows; r++){
+            if(r >= begin && r < end){
+                folds[i].test.push_back(r);
+            } else {
+                folds[i].train.push_back(r);
+            }
+        }
+        begin = end;
+    }
+    return folds;
+}
+
+/**
+ * @brief Walk-forward splits for time series.
+ *
+ * @details
+ * The last nFolds × testSize rows are cut into nFolds consecutive test windows.
+ * The training part of a fold ends directly before its test window and
+ *
+ * - **expanding**: starts at row 0
+ * - **sliding**: contains the trainSize rows before the test window
+ *
+ * @param nRows number of rows of the data set
+ * @param nFolds number of test windows
+ * @param testSize rows per test window
+ * @param window "expanding" or "sliding"
+ * @param trainSize rows of the training window (used by "sliding")
+ */
+inline std::vector<Fold> walkForwardSplits(
+        size_t nRows,
+        size_t nFolds,
+        size_t testSize,
+        const std::string& window = "expanding",
+        size_t trainSize = 0
+        ){
+    if(window != "expanding" && window != "sliding"){
+        throw std::invalid_argument("unknown walk-forward window: " + window + " (use expanding or sliding)");
+    }
+    if(nFolds == 0 || testSize == 0 || nFolds * testSize >= nRows){
+        throw std::invalid_argument("walk-forward test windows must leave rows for training");
+    }
+    size_t firstTest = nRows - nFolds * testSize;
+    if(window == "sliding" && (trainSize == 0 || trainSize > firstTest)){
+        throw std::invalid_argument("sliding training window must fit before the first test window");
+    }
+    std::vector<Fold> folds(nFolds);
+    for(size_t i=0; i<nFolds; i++){
+        size_t testBegin = firstTest + i * testSize;
+        size_t trainBegin = window == "expanding" ? 0 : testBegin - trainSize;
+        for(size_t r=trainBegin; r<testBegin; r++){
+            folds[i].train.push_back(r);
+        }
+        for(size_t r=testBegin; r<testBegin+testSize; r++){
+            folds[i].test.push_back(r);
+        }
+    }
+    return folds;
+}
+
+/**
+ * @brief Checks that all fold indices address rows of the data set.
+ * @param folds fold index sets
+ * @param nRows number of rows of the data set
+ */
+inline void checkFolds(const std::vector<Fold>& folds, size_t nRows){
+    if(folds.empty()){
+        throw std::invalid_argument("at least one fold is required");
+    }
+    for(const Fold& fold : folds){
+        for(const std::vector<size_t>* part : {&fold.train, &fold.test}){
+            for(size_t r : *part){
+                if(r >= nRows){
+                    throw std::invalid_argument("fold index out of range");
+                }
+            }
+        }
+    }
+}
+
+#endif
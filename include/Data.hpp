@@ -5,6 +5,39 @@
 #include <fstream>
 #include <vector>
 #include <sstream>
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+#include <cstdint>
+
+/**
+ * @struct DerivedFeature
+ * @brief Specification of a virtual feature column that is computed from X on demand.
+ *
+ * @details
+ * Derived features are never materialised. Judgment nodes address them with
+ * feature indices behind the base columns of X (see Data::nFeatures()), and
+ * their values are computed while the network traverses the data
+ * (see Data::FeatureCursor).
+ *
+ * Supported kinds:
+ * - **Lag**: x[t-k] of the base column
+ * - **Diff**: x[t] - x[t-k] of the base column
+ * - **RollingMean**: mean of the base column over the last w rows
+ * - **RollingStd**: (population) standard deviation of the base column over the last w rows
+ * - **Ratio**: x_a[t] / x_b[t] of two base columns
+ *
+ * @note Rows before the start of the data are padded with the first row, so lags
+ * repeat the first value, differences start at 0 and rolling windows shrink at the start.
+ */
+struct DerivedFeature {
+    enum class Kind { Lag, Diff, RollingMean, RollingStd, Ratio };
+    Kind kind; /**< kind of the derived feature */
+    int column; /**< base column of X (numerator for Ratio) */
+    int param; /**< lag k, window w or denominator column (Ratio) */
+};
 
 /**
  * @class Data 
@@ -20,6 +53,7 @@ class Data {
         std::vector<int> XIndices;
         std::vector<float> minX;
         std::vector<float> maxX;
+        std::vector<DerivedFeature> derivedFeatures; /**< virtual feature columns appended behind the columns of X */
         
         /**
          * @fn readCSV
@@ -54,6 +88,45 @@ class Data {
             file.close();
         }
 
+        /**
+         * @fn readBinary
+         * @brief read a binary float32 matrix and stores it in member dt.
+         * @details
+         * The file starts with the number of rows and columns as two little-endian
+         * uint64 values, followed by rows × columns float32 values in row-major order
+         * (e.g. written with numpy: `np.array(X.shape, '<u8').tofile(f); X.astype('<f4').tofile(f)`).
+         * Large datasets load without parsing text.
+         * @param filename (string&)
+         * @throws std::runtime_error if the file cannot be read or is smaller than its header states
+         */
+        void readBinary(const std::string& filename){
+            std::ifstream file(filename, std::ios::binary);
+            if(!file.is_open()){
+                throw std::runtime_error("cannot read data file " + filename);
+            }
+            uint64_t shape[2];
+            if(!file.read(reinterpret_cast<char*>(shape), sizeof(shape))){
+                throw std::runtime_error("data file " + filename + " has no shape header");
+            }
+            // check the shape against the file size before anything is allocated
+            std::streamoff header = file.tellg();
+            file.seekg(0, std::ios::end);
+            uint64_t payload = static_cast<uint64_t>(file.tellg() - header);
+            file.seekg(header);
+            bool fits = shape[1] == 0 ? shape[0] == 0 : shape[0] <= payload / sizeof(float) / shape[1];
+            if(!fits){
+                throw std::runtime_error("data file " + filename + " is smaller than its shape header states");
+            }
+            std::vector<float> row(shape[1]);
+            dt.reserve(dt.size() + shape[0]);
+            for(uint64_t r=0; r<shape[0]; r++){
+                if(!file.read(reinterpret_cast<char*>(row.data()), row.size() * sizeof(float))){
+                    throw std::runtime_error("data file " + filename + " is truncated");
+                }
+                dt.push_back(row);
+            }
+        }
+
         /**
          * @fn printRows
          * @brief print rows of member dt.
@@ -125,6 +198,285 @@ class Data {
                 maxX.push_back(max);
             }
         }
+
+        /**
+         * @fn nFeatures
+         * @brief number of features addressable by judgment nodes (columns of X plus derived features).
+         * @note use this value as jnf if derived features should be used by the population
+         */
+        size_t nFeatures() const {
+            size_t nBase = X.empty() ? 0 : X[0].size();
+            return nBase + derivedFeatures.size();
+        }
+
+        /**
+         * @fn addLagFeature
+         * @brief declares the virtual feature x[t-k] of a column of X.
+         * @param column (int) : base column of X
+         * @param k (int) : lag (k >= 1)
+         * @return feature index of the new feature (usable as node function f)
+         */
+        int addLagFeature(int column, int k){
+            return addDerivedFeature({DerivedFeature::Kind::Lag, column, k});
+        }
+
+        /**
+         * @fn addDiffFeature
+         * @brief declares the virtual feature x[t] - x[t-k] of a column of X.
+         * @param column (int) : base column of X
+         * @param k (int) : step width (k >= 1)
+         * @return feature index of the new feature
+         */
+        int addDiffFeature(int column, int k){
+            return addDerivedFeature({DerivedFeature::Kind::Diff, column, k});
+        }
+
+        /**
+         * @fn addRollingMeanFeature
+         * @brief declares the virtual rolling mean of a column of X over the last w rows.
+         * @param column (int) : base column of X
+         * @param w (int) : window length (w >= 1)
+         * @return feature index of the new feature
+         */
+        int addRollingMeanFeature(int column, int w){
+            return addDerivedFeature({DerivedFeature::Kind::RollingMean, column, w});
+        }
+
+        /**
+         * @fn addRollingStdFeature
+         * @brief declares the virtual rolling standard deviation of a column of X over the last w rows.
+         * @param column (int) : base column of X
+         * @param w (int) : window length (w >= 1)
+         * @return feature index of the new feature
+         */
+        int addRollingStdFeature(int column, int w){
+            return addDerivedFeature({DerivedFeature::Kind::RollingStd, column, w});
+        }
+
+        /**
+         * @fn addRatioFeature
+         * @brief declares the virtual feature x_a[t] / x_b[t] of two columns of X.
+         * @note a zero denominator yields 0
+         * @param numerator (int) : base column a of X
+         * @param denominator (int) : base column b of X
+         * @return feature index of the new feature
+         */
+        int addRatioFeature(int numerator, int denominator){
+            return addDerivedFeature({DerivedFeature::Kind::Ratio, numerator, denominator});
+        }
+
+        /**
+         * @fn derivedValue
+         * @brief computes a derived feature for a single row from scratch.
+         * @note rolling features cost O(w) here; sequential access should use FeatureCursor.
+         * @param row (size_t) : row of X
+         * @param feature (DerivedFeature) : feature specification
+         * @param first (size_t) : first row of the series the row belongs to (padding starts here)
+         */
+        float derivedValue(size_t row, const DerivedFeature& feature, size_t first = 0) const {
+            const int c = feature.column;
+            switch(feature.kind){
+                case DerivedFeature::Kind::Lag:
+                    return X[lagRow(row, feature.param, first)][c];
+                case DerivedFeature::Kind::Diff:
+                    return X[row][c] - X[lagRow(row, feature.param, first)][c];
+                case DerivedFeature::Kind::Ratio:
+                    return ratio(X[row][c], X[row][feature.param]);
+                case DerivedFeature::Kind::RollingMean:
+                case DerivedFeature::Kind::RollingStd: {
+                    double sum = 0;
+                    double sumSq = 0;
+                    size_t start = windowStart(row, feature.param, first);
+                    for(size_t r=start; r<=row; r++){
+                        sum += X[r][c];
+                        sumSq += static_cast<double>(X[r][c]) * X[r][c];
+                    }
+                    return rollingValue(feature.kind, sum, sumSq, row - start + 1);
+                }
+            }
+            return 0;
+        }
+
+        /**
+         * @fn minMaxDerivedFeatures
+         * @brief finds min and max of all derived features and stores them behind the bounds of X in minX and maxX.
+         * @note minX/maxX are truncated to the columns of X first (computed by minMaxFeatures(X) if
+         *  missing), so repeated calls keep them indexed like the node functions f
+         */
+        void minMaxDerivedFeatures(){
+            if(X.empty()){
+                return;
+            }
+            size_t nBase = X[0].size();
+            if(minX.size() < nBase || maxX.size() < nBase){
+                minX.clear();
+                maxX.clear();
+                minMaxFeatures(X);
+            }
+            minX.resize(nBase);
+            maxX.resize(nBase);
+            if(derivedFeatures.empty()){
+                return;
+            }
+            std::vector<float> minD(derivedFeatures.size(), std::numeric_limits<float>::max());
+            std::vector<float> maxD(derivedFeatures.size(), std::numeric_limits<float>::lowest());
+            FeatureCursor cursor(*this);
+            for(size_t r=0; r<X.size(); r++){
+                cursor.seek(r);
+                for(size_t j=0; j<derivedFeatures.size(); j++){
+                    float v = cursor[nBase+j];
+                    minD[j] = std::min(minD[j], v);
+                    maxD[j] = std::max(maxD[j], v);
+                }
+            }
+            minX.insert(minX.end(), minD.begin(), minD.end());
+            maxX.insert(maxX.end(), maxD.begin(), maxD.end());
+        }
+
+        /**
+         * @class FeatureCursor
+         * @brief Row accessor over X and the derived features of a Data object.
+         *
+         * @details
+         * The cursor is passed to Network::decisionAndNextNode() like a row of X.
+         * Feature indices below the number of columns of X return the stored value,
+         * higher indices return the derived feature. Rolling sums are kept as incremental
+         * buffers while the cursor moves forward row by row, so sequential traversal costs
+         * O(1) per rolling feature and row; lags, differences and ratios are computed
+         * only when a judgment node reads them.
+         */
+        class FeatureCursor {
+            public:
+                /**
+                 * @param _data data with X and derived features (must outlive the cursor)
+                 * @param _first first row of the series; lags and windows never reach before it
+                 */
+                explicit FeatureCursor(const Data& _data, size_t _first = 0):
+                    data(_data),
+                    first(_first),
+                    nBase(_data.X.empty() ? 0 : _data.X[0].size()),
+                    sum(_data.derivedFeatures.size(), 0),
+                    sumSq(_data.derivedFeatures.size(), 0)
+                {}
+
+                /**
+                 * @brief moves the cursor to a row.
+                 * @note moving to the next row updates the rolling buffers incrementally,
+                 * any other jump rebuilds them.
+                 */
+                void seek(size_t _row){
+                    if(valid && _row == row + 1){
+                        row = _row;
+                        for(size_t j=0; j<data.derivedFeatures.size(); j++){
+                            const auto& feature = data.derivedFeatures[j];
+                            if(!isRolling(feature)){
+                                continue;
+                            }
+                            double add = data.X[row][feature.column];
+                            sum[j] += add;
+                            sumSq[j] += add * add;
+                            if(row >= first + feature.param){ // row leaves the window
+                                double sub = data.X[row - feature.param][feature.column];
+                                sum[j] -= sub;
+                                sumSq[j] -= sub * sub;
+                            }
+                        }
+                    } else {
+                        row = _row;
+                        rebuild();
+                    }
+                }
+
+                /**
+                 * @brief restarts the cursor at the beginning of a new series.
+                 */
+                void reset(size_t _first){
+                    first = _first;
+                    valid = false;
+                }
+
+                /**
+                 * @brief value of feature f in the current row.
+                 */
+                float operator[](size_t f) const {
+                    if(f < nBase){
+                        return data.X[row][f];
+                    }
+                    size_t j = f - nBase;
+                    const auto& feature = data.derivedFeatures[j];
+                    if(isRolling(feature)){
+                        size_t n = row - windowStart(row, feature.param, first) + 1;
+                        return rollingValue(feature.kind, sum[j], sumSq[j], n);
+                    }
+                    return data.derivedValue(row, feature, first);
+                }
+
+            private:
+                const Data& data;
+                size_t first;
+                size_t nBase;
+                size_t row = 0;
+                bool valid = false;
+                std::vector<double> sum;
+                std::vector<double> sumSq;
+
+                void rebuild(){
+                    for(size_t j=0; j<data.derivedFeatures.size(); j++){
+                        const auto& feature = data.derivedFeatures[j];
+                        sum[j] = 0;
+                        sumSq[j] = 0;
+                        if(!isRolling(feature)){
+                            continue;
+                        }
+                        for(size_t r=windowStart(row, feature.param, first); r<=row; r++){
+                            double v = data.X[r][feature.column];
+                            sum[j] += v;
+                            sumSq[j] += v * v;
+                        }
+                    }
+                    valid = true;
+                }
+        };
+
+    private:
+
+        int addDerivedFeature(const DerivedFeature& feature){
+            int nBase = X.empty() ? 0 : X[0].size();
+            bool ratio = feature.kind == DerivedFeature::Kind::Ratio;
+            if(feature.column < 0 || feature.column >= nBase ||
+               (ratio && (feature.param < 0 || feature.param >= nBase))){
+                throw std::invalid_argument("derived feature refers to a column outside of X");
+            }
+            if(!ratio && feature.param < 1){
+                throw std::invalid_argument("lag and window length of a derived feature must be >= 1");
+            }
+            derivedFeatures.push_back(feature);
+            return nBase + derivedFeatures.size() - 1;
+        }
+
+        static bool isRolling(const DerivedFeature& feature){
+            return feature.kind == DerivedFeature::Kind::RollingMean || feature.kind == DerivedFeature::Kind::RollingStd;
+        }
+
+        static size_t lagRow(size_t row, int k, size_t first){
+            return row >= first + k ? row - k : first;
+        }
+
+        static size_t windowStart(size_t row, int w, size_t first){
+            return row + 1 >= first + w ? row + 1 - w : first;
+        }
+
+        static float ratio(float a, float b){
+            return b == 0 ? 0.0f : a / b;
+        }
+
+        static float rollingValue(DerivedFeature::Kind kind, double sum, double sumSq, size_t n){
+            double mean = sum / n;
+            if(kind == DerivedFeature::Kind::RollingMean){
+                return mean;
+            }
+            return std::sqrt(std::max(0.0, sumSq / n - mean * mean));
+        }
 };
 #endif
 
@@ -0,0 +1,128 @@
+#ifndef DECISIONBUFFER_HPP
+#define DECISIONBUFFER_HPP
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @class DecisionBuffer
+ * @brief Bit-packed sequence of decisions with explicit invalid rows.
+ *
+ * @details
+ * Decisions are processing node functions in [0, pnf), so they are stored with the
+ * smallest power-of-two number of bits that holds pnf values:
+ *
+ * | pnf        | bits per decision |
+ * |------------|-------------------|
+ * | ≤ 2        | 1                 |
+ * | ≤ 4        | 2                 |
+ * | ≤ 16       | 4                 |
+ * | ≤ 256      | 8                 |
+ * | ≤ 65536    | 16                |
+ * | otherwise  | 32                |
+ *
+ * Rows on which the network became invalid (dMax exceeded) hold no decision; they
+ * are listed in invalidRows() instead of being encoded as a sentinel value.
+ */
+class DecisionBuffer {
+    public:
+        /**
+         * @param pnf number of processing node functions (decisions are in [0, pnf))
+         */
+        explicit DecisionBuffer(unsigned int pnf = 256):
+            bits(bitsFor(pnf))
+        {}
+
+        /**
+         * @brief Smallest supported number of bits for decisions in [0, pnf).
+         */
+        static unsigned int bitsFor(unsigned int pnf){
+            unsigned int b = 1;
+            while(b < 32 && (pnf - 1) >> b != 0){
+                b *= 2;
+            }
+            return pnf <= 1 ? 1 : b;
+        }
+
+        /**
+         * @brief Clears the buffer and sets the width for decisions in [0, pnf).
+         */
+        void reset(unsigned int pnf){
+            bits = bitsFor(pnf);
+            clear();
+        }
+
+        /** @brief Removes all decisions (keeps the allocated memory). */
+        void clear(){
+            words.clear();
+            invalid.clear();
+            n = 0;
+        }
+
+        /** @brief Reserves memory for nRows decisions. */
+        void reserve(size_t nRows){
+            words.reserve((nRows * bits + 63) / 64);
+        }
+
+        /**
+         * @brief Appends a decision.
+         * @param decision value in [0, 2^bitsPerDecision())
+         */
+        void push_back(uint32_t decision){
+            size_t bit = n * bits;
+            if(bit / 64 >= words.size()){
+                words.push_back(0);
+            }
+            words[bit / 64] |= static_cast<uint64_t>(decision & mask()) << (bit % 64);
+            n ++;
+        }
+
+        /** @brief Appends a row without decision (network invalid on this row). */
+        void pushInvalid(){
+            invalid.push_back(n);
+            push_back(0);
+        }
+
+        /** @brief Decision of a row (0 for invalid rows, see isInvalid()). */
+        uint32_t operator[](size_t row) const {
+            size_t bit = row * bits;
+            return static_cast<uint32_t>(words[bit / 64] >> (bit % 64)) & mask();
+        }
+
+        /** @brief True if the network was invalid on this row. */
+        bool isInvalid(size_t row) const {
+            return std::binary_search(invalid.begin(), invalid.end(), row);
+        }
+
+        size_t size() const { return n; } /**< number of rows */
+        unsigned int bitsPerDecision() const { return bits; } /**< width of one decision */
+        size_t bytes() const { return words.size() * sizeof(uint64_t); } /**< memory of the packed decisions */
+        const std::vector<size_t>& invalidRows() const { return invalid; } /**< ascending rows without decision */
+
+        /**
+         * @brief Unpacks all decisions.
+         * @param invalidValue value stored for invalid rows
+         */
+        std::vector<int> toVector(int invalidValue = -1) const {
+            std::vector<int> out(n);
+            for(size_t i=0; i<n; i++){
+                out[i] = (*this)[i];
+            }
+            for(size_t row : invalid){
+                out[row] = invalidValue;
+            }
+            return out;
+        }
+
+    private:
+        unsigned int bits;
+        size_t n = 0;
+        std::vector<uint64_t> words;
+        std::vector<size_t> invalid;
+
+        // bits divides 64, so a decision never straddles two words
+        uint32_t mask() const { return bits == 32 ? 0xffffffffu : (1u << bits) - 1; }
+};
+
+#endif
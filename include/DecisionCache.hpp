@@ -0,0 +1,192 @@
+#ifndef DECISIONCACHE_HPP
+#define DECISIONCACHE_HPP
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "Hash.hpp"
+#include "Node.hpp"
+
+/**
+ * @struct DecisionCacheStats
+ * @brief Counters of a DecisionCache.
+ */
+struct DecisionCacheStats {
+    size_t hits = 0; /**< judgment chains answered from the cache */
+    size_t misses = 0; /**< judgment chains traversed and stored */
+    size_t bypassed = 0; /**< observations with NaN features (traversed, not cached) */
+    size_t evictions = 0; /**< stored entries that replaced another key */
+    size_t rebuilds = 0; /**< quantisation tables built (first use, genome or dMax changed) */
+
+    /** @brief hits / (hits + misses), 0 before the first lookup. */
+    float hitRate() const {
+        size_t lookups = hits + misses;
+        return lookups > 0 ? static_cast<float>(hits) / lookups : 0;
+    }
+};
+
+/**
+ * @class DecisionCache
+ * @brief Bounded memo of judgment chains keyed by (current node, quantised observation).
+ *
+ * @details
+ * A deployed controller often sees the same observations again (e.g. a discretised
+ * sensor). From a judgment node, the traversal up to the next processing node only
+ * depends on how every read feature compares to the boundaries of the judgment nodes.
+ * The cache therefore quantises each feature by the union of all boundaries of the
+ * judgment nodes reading it: the code of a value v is 2·i + e, where i is the number of
+ * boundaries below v and e = 1 if v equals boundary i. Two observations with the same
+ * codes take the same path, so a hit returns exactly the decision and the next node of
+ * the uncached traversal (Node::judge() is evaluated on the float value; the cache
+ * quantises the same float).
+ *
+ * The table is direct-mapped with capacity() slots: a lookup hashes the key to one slot,
+ * a store overwrites that slot. Lookup and store are O(F) for F judged features,
+ * independent of the length of the judgment chain.
+ *
+ * The quantisation tables depend on the genome and on dMax; Network::genomeChanged()
+ * invalidates them and they are rebuilt on the next lookup.
+ *
+ * @see Network::setDecisionCache()
+ */
+class DecisionCache {
+    public:
+        /**
+         * @struct Entry
+         * @brief Outcome of one judgment chain.
+         */
+        struct Entry {
+            int decision = 0; /**< function of the reached processing node */
+            int next = -1; /**< current node after the step */
+            int steps = 0; /**< traversed edges (added to Network::traverseCounter) */
+            bool invalid = false; /**< true if dMax was exceeded */
+        };
+
+        /**
+         * @param _capacity number of slots (0 = disabled)
+         */
+        explicit DecisionCache(size_t _capacity = 0): slots(_capacity) {}
+
+        bool enabled() const { return slots > 0; } /**< true if the cache has slots */
+
+        /** @brief Marks the quantisation tables and entries as outdated. */
+        void invalidate(){
+            ready = false;
+        }
+
+        /** @brief True if the tables are valid for dMax. */
+        bool matches(int dMax) const {
+            return ready && dMax == builtDMax;
+        }
+
+        /**
+         * @brief Builds the quantisation tables of a genome and empties the slots.
+         * @param innerNodes inner nodes of the network
+         * @param dMax dMax of the traversal (part of the outcome of a chain)
+         */
+        void prepare(const std::vector<Node>& innerNodes, int dMax){
+            features.clear();
+            for(const Node& node : innerNodes){
+                if(node.type == "J"){
+                    features.push_back(node.f);
+                }
+            }
+            std::sort(features.begin(), features.end());
+            features.erase(std::unique(features.begin(), features.end()), features.end());
+            cuts.assign(features.size(), {});
+            for(const Node& node : innerNodes){
+                if(node.type == "J"){
+                    size_t i = std::lower_bound(features.begin(), features.end(), node.f) - features.begin();
+                    cuts[i].insert(cuts[i].end(), node.boundaries.begin(), node.boundaries.end());
+                }
+            }
+            for(auto& c : cuts){
+                std::sort(c.begin(), c.end());
+                c.erase(std::unique(c.begin(), c.end()), c.end());
+            }
+            codes.assign(features.size(), 0);
+            keys.assign(slots * features.size(), 0);
+            nodes.assign(slots, -1);
+            entries.assign(slots, Entry{});
+            builtDMax = dMax;
+            ready = true;
+            measured.rebuilds++;
+        }
+
+        /**
+         * @brief Quantises an observation into the current key.
+         * @return false if a judged feature is NaN (such observations are not cached)
+         */
+        template <typename dataContainer>
+        bool encode(const dataContainer& data){
+            hash = 0;
+            for(size_t i=0; i<features.size(); i++){
+                double v = static_cast<float>(data[features[i]]); // the value seen by Node::judge()
+                if(std::isnan(v)){
+                    measured.bypassed++;
+                    return false;
+                }
+                const std::vector<double>& c = cuts[i];
+                size_t below = std::lower_bound(c.begin(), c.end(), v) - c.begin();
+                uint32_t code = 2 * below + (below < c.size() && c[below] == v);
+                codes[i] = code;
+                hash = splitmix64(hash ^ code);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Entry of the current key (see encode()) at a node, or nullptr.
+         */
+        const Entry* find(int node){
+            size_t slot = slotOf(node);
+            if(nodes[slot] == node && std::equal(codes.begin(), codes.end(), keys.begin() + slot * codes.size())){
+                measured.hits++;
+                return &entries[slot];
+            }
+            measured.misses++;
+            return nullptr;
+        }
+
+        /**
+         * @brief Stores the outcome of the current key (see encode()) at a node.
+         */
+        void store(int node, const Entry& entry){
+            size_t slot = slotOf(node);
+            if(nodes[slot] != -1){
+                measured.evictions++;
+            }
+            nodes[slot] = node;
+            std::copy(codes.begin(), codes.end(), keys.begin() + slot * codes.size());
+            entries[slot] = entry;
+        }
+
+        /** @brief Counters since construction or the last resetStats(). */
+        const DecisionCacheStats& stats() const { return measured; }
+
+        /** @brief Resets the counters. */
+        void resetStats(){
+            measured = DecisionCacheStats();
+        }
+
+        size_t capacity() const { return slots; } /**< number of slots */
+
+    private:
+        size_t slots;
+        bool ready = false;
+        int builtDMax = 0;
+        std::vector<unsigned int> features; // judged features (ascending)
+        std::vector<std::vector<double>> cuts; // sorted distinct boundaries per judged feature
+        std::vector<uint32_t> codes; // quantised current observation
+        uint64_t hash = 0; // hash of codes
+        std::vector<uint32_t> keys; // slots x features.size() codes
+        std::vector<int> nodes; // node of each slot (-1 = empty)
+        std::vector<Entry> entries;
+        DecisionCacheStats measured;
+
+        size_t slotOf(int node) const {
+            return splitmix64(hash ^ (static_cast<uint64_t>(node) << 32)) % slots;
+        }
+};
+
+#endif
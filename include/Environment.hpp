@@ -0,0 +1,90 @@
+#ifndef ENVIRONMENT_HPP
+#define ENVIRONMENT_HPP
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <vector>
+
+/**
+ * @file Environment.hpp
+ * @brief Interpreter-free interface of reinforcement learning environments.
+ *
+ * @details
+ * Network::fitGymnasium() and Population::gymnasium() accept any type that satisfies
+ * the Environment concept. The Python bindings adapt Gymnasium environments with
+ * GymEnvWrapper (GymnasiumWrapper.hpp, the only header that depends on pybind11);
+ * native applications can provide their own environments without linking Python.
+ */
+
+/**
+ * @struct EnvironmentStep
+ * @brief Result of one environment step (observation, reward, terminated, truncated).
+ */
+struct EnvironmentStep {
+    std::vector<double> observation; /**< observation after the step */
+    float reward = 0; /**< reward of the step */
+    bool terminated = false; /**< episode ended in a terminal state */
+    bool truncated = false; /**< episode ended by a time limit of the environment */
+};
+
+/**
+ * @struct EpisodeBound
+ * @brief Opt-in bound for cutting episodes short that cannot reach a fitness threshold.
+ *
+ * @details
+ * With a per-generation threshold (e.g. the fitness needed to enter the elite) and an
+ * upper bound of the reward of a single step, an episode whose return so far plus
+ * maxStepReward on every remaining step stays below the threshold cannot become
+ * competitive anymore. Such episodes are stopped and the network is marked as
+ * truncated.
+ *
+ * The fitness of a truncated episode is its best reachable return (see best()): the
+ * return so far plus maxStepReward on every step it did not run. This is the return
+ * of a full run in which the unknown rewards are replaced by their bound, so it stays
+ * below the threshold and still ranks truncated networks by how close they came.
+ *
+ * The default bound is inactive. The bound is only safe if maxStepReward is a true
+ * upper bound of the environment's reward.
+ */
+struct EpisodeBound {
+    double threshold = -std::numeric_limits<double>::infinity(); /**< return an episode must still be able to reach */
+    double maxStepReward = std::numeric_limits<double>::infinity(); /**< upper bound of the reward of one step */
+
+    /** @brief True if both the threshold and the reward bound are set. */
+    bool active() const {
+        return std::isfinite(threshold) && std::isfinite(maxStepReward);
+    }
+
+    /**
+     * @brief True if the threshold cannot be reached anymore.
+     * @param episodeReturn return collected so far
+     * @param remainingSteps steps left until maxSteps
+     */
+    bool unreachable(double episodeReturn, int remainingSteps) const {
+        return active() && best(episodeReturn, remainingSteps) < threshold;
+    }
+
+    /**
+     * @brief Best return still reachable (the fitness of a truncated episode).
+     * @param episodeReturn return collected so far
+     * @param remainingSteps steps left until maxSteps
+     */
+    double best(double episodeReturn, int remainingSteps) const {
+        return episodeReturn + maxStepReward * remainingSteps;
+    }
+};
+
+/**
+ * @brief Environment usable by Network::fitGymnasium().
+ *
+ * @details
+ * - resetObservation(seed): starts a new episode and returns the initial observation
+ * - stepAction(action): executes a discrete action and returns an EnvironmentStep
+ */
+template <typename Env>
+concept Environment = requires(Env env, int seed, int action) {
+    { env.resetObservation(seed) } -> std::convertible_to<std::vector<double>>;
+    { env.stepAction(action) } -> std::convertible_to<EnvironmentStep>;
+};
+
+#endif
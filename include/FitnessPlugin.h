@@ -0,0 +1,62 @@
+#ifndef FITNESSPLUGIN_H
+#define FITNESSPLUGIN_H
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file FitnessPlugin.h
+ * @brief Stable C ABI for native fitness kernels loaded at runtime.
+ *
+ * @details
+ * A fitness kernel consumes the decision stream of one individual and returns its
+ * fitness. The evaluation engine calls, per individual and possibly on several
+ * threads at once:
+ *
+ * 1. create() with the row-major target matrix (nRows × nCols, e.g. labels or returns)
+ * 2. consume() once per row with the decision of the network
+ * 3. finish() to obtain the fitness (skipped if the network becomes invalid)
+ * 4. destroy() to release the state
+ *
+ * The state returned by create() belongs to one individual, so kernels only need to
+ * be thread-safe with respect to their userData.
+ *
+ * A plugin is a shared library that exports fracnetics_fitness_kernels():
+ *
+ * @code
+ * extern "C" const FracneticsFitnessKernel* fracnetics_fitness_kernels(size_t* count);
+ * @endcode
+ *
+ * This header is plain C so that plugins can be built without the fracnetics headers.
+ *
+ * @see loadFitnessPlugin(), FitnessRegistry
+ */
+
+/** version of the kernel struct; plugins must set abiVersion to this value */
+#define FRACNETICS_FITNESS_ABI_VERSION 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct FracneticsFitnessKernel
+ * @brief Function table of one fitness kernel.
+ */
+typedef struct FracneticsFitnessKernel {
+    uint32_t abiVersion; /**< must be FRACNETICS_FITNESS_ABI_VERSION */
+    const char* name; /**< name under which the kernel is registered */
+    void* userData; /**< passed unchanged to create() */
+    void* (*create)(void* userData, const float* targets, size_t nRows, size_t nCols); /**< new state for one individual */
+    void (*consume)(void* state, size_t row, int32_t decision); /**< one decision per row */
+    float (*finish)(void* state); /**< fitness of the individual */
+    void (*destroy)(void* state); /**< releases the state */
+} FracneticsFitnessKernel;
+
+/** signature of the function a plugin exports */
+typedef const FracneticsFitnessKernel* (*FracneticsFitnessKernelsFn)(size_t* count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,184 @@
+#ifndef FITNESSREGISTRY_HPP
+#define FITNESSREGISTRY_HPP
+#include <concepts>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "FitnessPlugin.h"
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
+/**
+ * @file FitnessRegistry.hpp
+ * @brief Registry of native fitness kernels selectable by name.
+ *
+ * @details
+ * Kernels are either compiled into the program (any type satisfying the FitnessKernel
+ * concept, see registerFitnessKernel()) or loaded from a shared-library plugin
+ * (see loadFitnessPlugin()). Both are stored as the C function table of FitnessPlugin.h,
+ * so the evaluation engine treats them the same way.
+ *
+ * @see Population::nativeFitness()
+ */
+
+/**
+ * @brief Fitness kernel written in C++.
+ *
+ * @details
+ * One object is constructed per individual from the row-major target matrix
+ * (targets, nRows, nCols), receives one decision per row and returns the fitness.
+ */
+template <typename K>
+concept FitnessKernel =
+    std::constructible_from<K, const float*, size_t, size_t> &&
+    requires(K kernel, size_t row, int32_t decision) {
+        kernel.consume(row, decision);
+        { kernel.finish() } -> std::convertible_to<float>;
+    };
+
+/**
+ * @brief Wraps a C++ kernel type into the C function table.
+ * @tparam K kernel type
+ * @param name name of the kernel
+ */
+template <FitnessKernel K>
+FracneticsFitnessKernel makeFitnessKernel(const char* name){
+    FracneticsFitnessKernel kernel{};
+    kernel.abiVersion = FRACNETICS_FITNESS_ABI_VERSION;
+    kernel.name = name;
+    kernel.userData = nullptr;
+    kernel.create = [](void*, const float* targets, size_t nRows, size_t nCols) -> void* {
+        return new K(targets, nRows, nCols);
+    };
+    kernel.consume = [](void* state, size_t row, int32_t decision){
+        static_cast<K*>(state)->consume(row, decision);
+    };
+    kernel.finish = [](void* state) -> float {
+        return static_cast<K*>(state)->finish();
+    };
+    kernel.destroy = [](void* state){
+        delete static_cast<K*>(state);
+    };
+    return kernel;
+}
+
+/**
+ * @class FitnessRegistry
+ * @brief Process-wide registry of fitness kernels.
+ *
+ * @details
+ * Registration and lookup are guarded by a mutex. find() returns a shared pointer to
+ * an immutable copy of the kernel, so an evaluation keeps using the kernel it looked up
+ * even if the name is registered again meanwhile (the new kernel only affects later
+ * lookups). Plugins are never unloaded, so their functions stay valid.
+ */
+class FitnessRegistry {
+    public:
+        /** @brief Returns the registry of the process. */
+        static FitnessRegistry& instance(){
+            static FitnessRegistry registry;
+            return registry;
+        }
+
+        /**
+         * @brief Registers a kernel (replaces a kernel with the same name).
+         * @param kernel function table; name must be set
+         */
+        void add(const FracneticsFitnessKernel& kernel){
+            if(kernel.abiVersion != FRACNETICS_FITNESS_ABI_VERSION){
+                throw std::invalid_argument("fitness kernel has an incompatible ABI version");
+            }
+            if(kernel.name == nullptr || !kernel.create || !kernel.consume || !kernel.finish || !kernel.destroy){
+                throw std::invalid_argument("fitness kernel must define a name and all functions");
+            }
+            auto entry = std::make_shared<Entry>();
+            entry->name = kernel.name;
+            entry->kernel = kernel;
+            entry->kernel.name = entry->name.c_str(); // the caller's string may not outlive the kernel
+            std::shared_ptr<const FracneticsFitnessKernel> shared(entry, &entry->kernel);
+            std::lock_guard<std::mutex> lock(mutex);
+            kernels[entry->name] = std::move(shared);
+        }
+
+        /**
+         * @brief Looks up a kernel by name.
+         * @return the kernel; it stays valid while the pointer is held, even if the name is
+         *  registered again
+         * @throws std::invalid_argument if no kernel with this name is registered
+         */
+        std::shared_ptr<const FracneticsFitnessKernel> find(const std::string& name) const {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = kernels.find(name);
+            if(it == kernels.end()){
+                throw std::invalid_argument("unknown fitness kernel: " + name);
+            }
+            return it->second;
+        }
+
+        /** @brief Names of all registered kernels. */
+        std::vector<std::string> names() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::vector<std::string> result;
+            for(const auto& entry : kernels){
+                result.push_back(entry.first);
+            }
+            return result;
+        }
+
+    private:
+        struct Entry {
+            std::string name; // owns the string kernel.name points to
+            FracneticsFitnessKernel kernel;
+        };
+
+        FitnessRegistry() = default;
+        mutable std::mutex mutex;
+        std::map<std::string, std::shared_ptr<const FracneticsFitnessKernel>> kernels;
+};
+
+/**
+ * @brief Registers a C++ kernel type under a name.
+ * @tparam K kernel type satisfying FitnessKernel
+ * @param name name of the kernel
+ */
+template <FitnessKernel K>
+void registerFitnessKernel(const std::string& name){
+    FitnessRegistry::instance().add(makeFitnessKernel<K>(name.c_str()));
+}
+
+/**
+ * @brief Loads a shared-library plugin and registers all of its kernels.
+ *
+ * @param path path of the shared library exporting fracnetics_fitness_kernels()
+ * @return names of the registered kernels
+ * @throws std::runtime_error if the library or its entry point cannot be loaded
+ */
+inline std::vector<std::string> loadFitnessPlugin(const std::string& path){
+#ifdef _WIN32
+    throw std::runtime_error("fitness plugins are not supported on this platform");
+#else
+    void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if(handle == nullptr){
+        throw std::runtime_error("cannot load fitness plugin " + path + ": " + dlerror());
+    }
+    auto entry = reinterpret_cast<FracneticsFitnessKernelsFn>(dlsym(handle, "fracnetics_fitness_kernels"));
+    if(entry == nullptr){
+        dlclose(handle);
+        throw std::runtime_error("fitness plugin " + path + " does not export fracnetics_fitness_kernels");
+    }
+    size_t count = 0;
+    const FracneticsFitnessKernel* kernels = entry(&count);
+    std::vector<std::string> names;
+    for(size_t i=0; i<count; i++){
+        FitnessRegistry::instance().add(kernels[i]);
+        names.push_back(kernels[i].name);
+    }
+    return names; // the handle stays open: the kernels point into the library
+#endif
+}
+
+#endif
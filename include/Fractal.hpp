@@ -1,7 +1,9 @@
 #ifndef FRACTAL_HPP
 #define FRACTAL_HPP
+#include <algorithm>
 #include <vector>
 #include <iostream>
+#include <memory>
 #include <random>
 
 /**
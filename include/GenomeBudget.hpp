@@ -0,0 +1,58 @@
+#ifndef GENOMEBUDGET_HPP
+#define GENOMEBUDGET_HPP
+#include <cstddef>
+
+/**
+ * @struct MemoryUsage
+ * @brief Genome size of a population (see Population::memoryUsage()).
+ */
+struct MemoryUsage {
+    size_t nodes = 0; /**< inner nodes of all individuals */
+    size_t bytes = 0; /**< genome bytes of all individuals (see Network::genomeBytes()) */
+    size_t largestNetwork = 0; /**< inner nodes of the largest individual */
+};
+
+/**
+ * @struct GenomeBudget
+ * @brief Upper limits of the total genome size of a population (0 = unlimited).
+ *
+ * @details
+ * Variable-size networks grow through addDelNodes() and randomWidth crossover. With an
+ * active budget the population enforces the limits (see Population::enforceBudget()):
+ * growth is rejected while the budget is exhausted, unreachable and then unused nodes
+ * are pruned from the largest individuals, and selection prefers the smaller individual
+ * at equal fitness.
+ */
+struct GenomeBudget {
+    size_t maxNodes = 0; /**< maximum inner nodes of all individuals together */
+    size_t maxBytes = 0; /**< maximum genome bytes of all individuals together */
+
+    /** @brief True if at least one limit is set. */
+    bool active() const {
+        return maxNodes > 0 || maxBytes > 0;
+    }
+
+    /** @brief True if the usage is above a limit. */
+    bool exceeded(const MemoryUsage& usage) const {
+        return (maxNodes > 0 && usage.nodes > maxNodes) || (maxBytes > 0 && usage.bytes > maxBytes);
+    }
+
+    /** @brief True if one more node (of average size) fits into the budget. */
+    bool allowsGrowth(const MemoryUsage& usage) const {
+        size_t nodeBytes = usage.nodes > 0 ? usage.bytes / usage.nodes : 0;
+        return (maxNodes == 0 || usage.nodes + 1 <= maxNodes) &&
+               (maxBytes == 0 || usage.bytes + nodeBytes <= maxBytes);
+    }
+};
+
+/**
+ * @struct BudgetStats
+ * @brief Counters of the budget enforcement of a population.
+ */
+struct BudgetStats {
+    size_t rejectedGrowth = 0; /**< addDelNodes() calls that were not allowed to add a node */
+    size_t prunedUnreachable = 0; /**< removed nodes that were not reachable from the start node */
+    size_t prunedUnused = 0; /**< removed reachable nodes that were not used in the last traversal */
+};
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef GENOMEVIEW_HPP
+#define GENOMEVIEW_HPP
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Network.hpp"
+
+/**
+ * @class GenomeView
+ * @brief Flat, array-based (CSR) representation of the genome of a network.
+ *
+ * @details
+ * The nodes of a Network are stored as an array of objects with their own edge and
+ * boundary vectors. A GenomeView packs the inner nodes into a few contiguous arrays,
+ * which Python can access as numpy arrays without copying (see the bindings):
+ *
+ * - **types**: node type per inner node ('J' or 'P' as character code)
+ * - **functions**: node function per inner node
+ * - **edgeOffsets**, **edgeTargets**: outgoing edges of node i are
+ *   edgeTargets[edgeOffsets[i] .. edgeOffsets[i+1])
+ * - **boundaryOffsets**, **boundaryValues**: boundaries of node i are
+ *   boundaryValues[boundaryOffsets[i] .. boundaryOffsets[i+1])
+ * - **startEdge**: successor of the start node
+ *
+ * The arrays can be modified freely (e.g. by custom mutation operators);
+ * applyTo() validates the whole genome before it is written back to a network.
+ *
+ * @nosubgrouping
+ */
+class GenomeView {
+    public:
+        std::vector<uint8_t> types; /**< 'J' or 'P' per inner node */
+        std::vector<int32_t> functions; /**< node function per inner node */
+        std::vector<int64_t> edgeOffsets; /**< CSR offsets into edgeTargets (number of nodes + 1) */
+        std::vector<int32_t> edgeTargets; /**< successor node ids */
+        std::vector<int64_t> boundaryOffsets; /**< CSR offsets into boundaryValues (number of nodes + 1) */
+        std::vector<double> boundaryValues; /**< boundaries of the judgment nodes */
+        int32_t startEdge = 0; /**< successor of the start node */
+
+        /**
+         * @brief Packs the genome of a network.
+         * @param network network to read
+         */
+        static GenomeView fromNetwork(const Network& network){
+            GenomeView view;
+            size_t n = network.innerNodes.size();
+            view.types.reserve(n);
+            view.functions.reserve(n);
+            view.edgeOffsets.reserve(n+1);
+            view.boundaryOffsets.reserve(n+1);
+            view.edgeOffsets.push_back(0);
+            view.boundaryOffsets.push_back(0);
+            for(const Node& node : network.innerNodes){
+                view.types.push_back(static_cast<uint8_t>(node.type[0]));
+                view.functions.push_back(node.f);
+                view.edgeTargets.insert(view.edgeTargets.end(), node.edges.begin(), node.edges.end());
+                view.boundaryValues.insert(view.boundaryValues.end(), node.boundaries.begin(), node.boundaries.end());
+                view.edgeOffsets.push_back(view.edgeTargets.size());
+                view.boundaryOffsets.push_back(view.boundaryValues.size());
+            }
+            view.startEdge = network.startNode.edges[0];
+            return view;
+        }
+
+        size_t size() const { return types.size(); } /**< number of inner nodes */
+
+        /**
+         * @brief Checks that the arrays describe a valid genome.
+         *
+         * @details
+         * - all per-node arrays have the same length and the offsets are consistent
+         * - types are 'J' or 'P'; functions are below jnf (judgment) or pnf (processing)
+         * - processing nodes have exactly one edge and no boundaries
+         * - judgment nodes have at least one edge and one more boundary than edges in
+         *   ascending order; only a genome without any boundaries (not yet set) may omit them
+         * - all edges (and the start edge) point to existing nodes without self-loops
+         *
+         * @param jnf number of judgment node functions
+         * @param pnf number of processing node functions
+         * @throws std::invalid_argument describing the first violation
+         */
+        void validate(unsigned int jnf, unsigned int pnf) const {
+            size_t n = size();
+            if(n == 0){
+                throw std::invalid_argument("genome must contain at least one inner node");
+            }
+            if(functions.size() != n || edgeOffsets.size() != n+1 || boundaryOffsets.size() != n+1){
+                throw std::invalid_argument("types, functions and offsets must describe the same number of nodes");
+            }
+            checkOffsets(edgeOffsets, edgeTargets.size(), "edge");
+            checkOffsets(boundaryOffsets, boundaryValues.size(), "boundary");
+            bool boundariesSet = !boundaryValues.empty();
+            if(startEdge < 0 || static_cast<size_t>(startEdge) >= n){
+                throw std::invalid_argument("start edge points to a non-existing node");
+            }
+            for(size_t i=0; i<n; i++){
+                std::string where = " (node " + std::to_string(i) + ")";
+                int64_t nEdges = edgeOffsets[i+1] - edgeOffsets[i];
+                int64_t nBoundaries = boundaryOffsets[i+1] - boundaryOffsets[i];
+                if(types[i] == 'P'){
+                    if(functions[i] < 0 || static_cast<unsigned int>(functions[i]) >= pnf){
+                        throw std::invalid_argument("processing node function out of range" + where);
+                    }
+                    if(nEdges != 1 || nBoundaries != 0){
+                        throw std::invalid_argument("processing nodes need exactly one edge and no boundaries" + where);
+                    }
+                } else if(types[i] == 'J'){
+                    if(functions[i] < 0 || static_cast<unsigned int>(functions[i]) >= jnf){
+                        throw std::invalid_argument("judgment node function out of range" + where);
+                    }
+                    if(nEdges < 1 || (boundariesSet && nBoundaries != nEdges+1)){
+                        throw std::invalid_argument("judgment nodes need edges and one boundary more than edges" + where);
+                    }
+                    for(int64_t b=boundaryOffsets[i]+1; b<boundaryOffsets[i+1]; b++){
+                        if(boundaryValues[b] < boundaryValues[b-1]){
+                            throw std::invalid_argument("boundaries must be ascending" + where);
+                        }
+                    }
+                } else {
+                    throw std::invalid_argument("node type must be 'J' or 'P'" + where);
+                }
+                for(int64_t e=edgeOffsets[i]; e<edgeOffsets[i+1]; e++){
+                    if(edgeTargets[e] < 0 || static_cast<size_t>(edgeTargets[e]) >= n){
+                        throw std::invalid_argument("edge points to a non-existing node" + where);
+                    }
+                    if(static_cast<size_t>(edgeTargets[e]) == i){
+                        throw std::invalid_argument("self-loops are not allowed" + where);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Validates the genome and writes it into a network.
+         *
+         * @details
+         * Existing nodes keep their fractal parameters as long as their type and number of
+         * edges are unchanged. Nodes whose type or edge count changes, and nodes beyond the
+         * current size of the network (which are appended), get no fractal parameters
+         * (k_d = {0, 0}): their boundaries are used as given and Node::boundaryMutationFractal()
+         * leaves them unchanged, like categorical judgment nodes. The node counters jn and pn
+         * are set to the numbers of judgment and processing nodes. The usage flags are cleared
+         * and genomeChanged() is called. The network is only modified if validation succeeds.
+         * A genome without boundaries is only accepted by a network whose boundaries are not
+         * set either (see Population::setAllNodeBoundaries()).
+         *
+         * @param network network to overwrite
+         * @throws std::invalid_argument if validate() fails or the genome has no boundaries
+         * but the network has
+         */
+        void applyTo(Network& network) const {
+            validate(network.jnf, network.pnf);
+            if(boundaryValues.empty()){
+                for(const Node& node : network.innerNodes){
+                    if(node.type == "J" && !node.boundaries.empty()){
+                        throw std::invalid_argument("a genome without boundaries cannot replace a network with boundaries");
+                    }
+                }
+            }
+            size_t n = size();
+            if(network.innerNodes.size() > n){
+                network.innerNodes.resize(n, network.startNode);
+            }
+            while(network.innerNodes.size() < n){
+                Node node = network.startNode; // shares the generator of the network
+                node.type.clear(); // no fractal parameters to keep
+                network.innerNodes.push_back(node);
+            }
+            network.jn = 0;
+            network.pn = 0;
+            for(size_t i=0; i<n; i++){
+                Node& node = network.innerNodes[i];
+                std::string type(1, static_cast<char>(types[i]));
+                size_t nEdges = edgeOffsets[i+1] - edgeOffsets[i];
+                if(node.type != type || node.edges.size() != nEdges){
+                    node.productionRuleParameter.clear();
+                    node.k_d = {0, 0};
+                }
+                (type == "J" ? network.jn : network.pn) += 1;
+                node.id = i;
+                node.type = type;
+                node.f = functions[i];
+                node.edges.assign(edgeTargets.begin()+edgeOffsets[i], edgeTargets.begin()+edgeOffsets[i+1]);
+                node.boundaries.assign(boundaryValues.begin()+boundaryOffsets[i], boundaryValues.begin()+boundaryOffsets[i+1]);
+                node.used = false;
+                node.traverseCounter = 0;
+            }
+            network.startNode.edges = {startEdge};
+            network.genomeChanged();
+        }
+
+    private:
+        static void checkOffsets(const std::vector<int64_t>& offsets, size_t nValues, const std::string& name){
+            if(offsets.front() != 0 || static_cast<size_t>(offsets.back()) != nValues){
+                throw std::invalid_argument(name + " offsets must start at 0 and end at the number of " + name + " values");
+            }
+            for(size_t i=1; i<offsets.size(); i++){
+                if(offsets[i] < offsets[i-1]){
+                    throw std::invalid_argument(name + " offsets must be non-decreasing");
+                }
+            }
+        }
+};
+
+#endif
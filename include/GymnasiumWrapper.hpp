@@ -2,6 +2,7 @@
 #define GYMNASIUM_WRAPPER_HPP
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include "Environment.hpp"
 
 namespace py = pybind11;
 using namespace py::literals;
@@ -26,6 +27,21 @@ public:
         return step(py::int_(action));
     }
 
+    // Environment interface (see Environment.hpp) used by Network::fitGymnasium()
+    std::vector<double> resetObservation(int seed) {
+        return reset(seed)[0].cast<std::vector<double>>();
+    }
+
+    EnvironmentStep stepAction(int action) {
+        py::tuple result = step(action);
+        return EnvironmentStep{
+            result[0].cast<std::vector<double>>(),
+            result[1].cast<float>(),
+            result[2].cast<bool>(),
+            result[3].cast<bool>()
+        };
+    }
+
     void render() {
         env.attr("render")();
     }
@@ -0,0 +1,24 @@
+#ifndef HASH_HPP
+#define HASH_HPP
+#include <cstdint>
+
+/**
+ * @file Hash.hpp
+ * @brief 64-bit mixing function shared by the hashed data structures.
+ */
+
+/**
+ * @brief splitmix64 finaliser: a fast bijective mix of all 64 bits.
+ *
+ * @details
+ * Used for MinHash shingles and bins (MinHashSketch), LSH signatures and band keys
+ * (BehaviorArchive) and the slots of the DecisionCache.
+ */
+inline uint64_t splitmix64(uint64_t x){
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @class ConfusionAccumulator
+ * @brief Streaming confusion counts of a classifier and the metrics derived from them.
+ *
+ * @details
+ * The accumulator is updated with one (label, decision) pair per row during the
+ * traversal, so no buffer of decisions is needed. Decisions outside [0, nClasses)
+ * (e.g. processing node functions without a class) count as wrong predictions
+ * of their true class.
+ *
+ * Metrics:
+ * - **accuracy**: correct / rows
+ * - **balancedAccuracy**: mean recall over the classes that occur in the labels
+ * - **macroF1**: mean F1 score over the classes that occur in labels or predictions
+ * - **kappa**: Cohen's kappa (agreement corrected for chance; 0 if chance agreement is 1)
+ */
+class ConfusionAccumulator {
+    public:
+        /**
+         * @param _nClasses number of classes (labels are 0 .. nClasses-1)
+         */
+        explicit ConfusionAccumulator(size_t _nClasses):
+            nClasses(_nClasses),
+            counts(_nClasses * _nClasses, 0),
+            nOther(_nClasses, 0)
+        {}
+
+        /**
+         * @brief Adds one row.
+         * @param label true class in [0, nClasses)
+         * @param decision predicted class
+         */
+        void update(int label, int decision){
+            if(decision >= 0 && static_cast<size_t>(decision) < nClasses){
+                counts[label * nClasses + decision] ++;
+            } else {
+                nOther[label] ++;
+            }
+            n ++;
+        }
+
+        /** @brief Number of rows with true class label and predicted class decision. */
+        size_t count(size_t label, size_t decision) const { return counts[label * nClasses + decision]; }
+
+        /** @brief Row-major (nClasses × nClasses) counts; rows are true classes. */
+        const std::vector<size_t>& matrix() const { return counts; }
+
+        double accuracy() const {
+            if(n == 0){
+                return 0;
+            }
+            size_t correct = 0;
+            for(size_t c=0; c<nClasses; c++){
+                correct += count(c, c);
+            }
+            return static_cast<double>(correct) / n;
+        }
+
+        double balancedAccuracy() const {
+            double sum = 0;
+            size_t present = 0;
+            for(size_t c=0; c<nClasses; c++){
+                size_t support = labelTotal(c);
+                if(support > 0){
+                    sum += static_cast<double>(count(c, c)) / support;
+                    present ++;
+                }
+            }
+            return present == 0 ? 0 : sum / present;
+        }
+
+        double macroF1() const {
+            double sum = 0;
+            size_t present = 0;
+            for(size_t c=0; c<nClasses; c++){
+                size_t support = labelTotal(c);
+                size_t predicted = predictionTotal(c);
+                if(support + predicted > 0){
+                    sum += 2.0 * count(c, c) / (support + predicted);
+                    present ++;
+                }
+            }
+            return present == 0 ? 0 : sum / present;
+        }
+
+        double kappa() const {
+            if(n == 0){
+                return 0;
+            }
+            double observed = accuracy();
+            double expected = 0;
+            for(size_t c=0; c<nClasses; c++){
+                expected += static_cast<double>(labelTotal(c)) * predictionTotal(c);
+            }
+            expected /= static_cast<double>(n) * n;
+            return expected >= 1 ? 0 : (observed - expected) / (1 - expected);
+        }
+
+        /**
+         * @brief Metric by name.
+         * @param metric "accuracy", "balancedAccuracy", "macroF1" or "kappa"
+         */
+        double score(const std::string& metric) const {
+            if(metric == "accuracy"){
+                return accuracy();
+            } else if(metric == "balancedAccuracy"){
+                return balancedAccuracy();
+            } else if(metric == "macroF1"){
+                return macroF1();
+            } else if(metric == "kappa"){
+                return kappa();
+            }
+            throw std::invalid_argument("unknown classification metric: " + metric);
+        }
+
+        /**
+         * @brief checks a metric name before an evaluation starts.
+         */
+        static void checkMetric(const std::string& metric){
+            if(metric != "accuracy" && metric != "balancedAccuracy" && metric != "macroF1" && metric != "kappa"){
+                throw std::invalid_argument("unknown classification metric: " + metric +
+                                            " (use accuracy, balancedAccuracy, macroF1 or kappa)");
+            }
+        }
+
+    private:
+        size_t nClasses;
+        std::vector<size_t> counts;
+        std::vector<size_t> nOther; // per true class: decisions outside [0, nClasses)
+        size_t n = 0;
+
+        size_t labelTotal(size_t label) const {
+            size_t sum = nOther[label];
+            for(size_t d=0; d<nClasses; d++){
+                sum += count(label, d);
+            }
+            return sum;
+        }
+
+        size_t predictionTotal(size_t decision) const {
+            size_t sum = 0;
+            for(size_t l=0; l<nClasses; l++){
+                sum += count(l, decision);
+            }
+            return sum;
+        }
+};
+
+#endif
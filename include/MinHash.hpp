@@ -0,0 +1,213 @@
+#ifndef MINHASH_HPP
+#define MINHASH_HPP
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include "Hash.hpp"
+
+/**
+ * @file MinHash.hpp
+ * @brief MinHash sketches of network structure and population diversity statistics.
+ *
+ * @details
+ * Every network keeps a MinHash sketch of its canonicalised reachable (node, edge)
+ * shingles (see Network::minHash()). The sketch is rebuilt lazily: genetic operators
+ * mark it dirty through Network::genomeChanged(), so per generation only the modified
+ * individuals are sketched again, each in O(E + K) by one-permutation hashing.
+ * Population::diversity() then derives all statistics from the sketches in O(ni·K)
+ * without comparing pairs of networks.
+ */
+
+/**
+ * @class MinHashSketch
+ * @brief One-permutation MinHash sketch of a set of 64-bit shingle hashes.
+ *
+ * @details
+ * Each shingle is hashed once; the hash selects one of K bins and the bin keeps the
+ * minimum. Empty bins are filled from the next non-empty bin (rotation densification),
+ * so the fraction of equal bins of two sketches estimates the Jaccard similarity of
+ * the shingle sets.
+ */
+class MinHashSketch {
+    public:
+        std::vector<uint64_t> values; /**< minimum per bin (K bins) */
+        bool dirty = true; /**< true if the genome changed since the last build() */
+
+        /** @brief Marks the sketch as outdated. */
+        void invalidate(){
+            dirty = true;
+        }
+
+        /**
+         * @brief Builds the sketch of a shingle set.
+         * @param shingles shingle hashes (duplicates are harmless)
+         * @param K number of bins (>= 1)
+         */
+        void build(const std::vector<uint64_t>& shingles, size_t K){
+            if(K == 0){
+                throw std::invalid_argument("a MinHash sketch needs K >= 1 bins");
+            }
+            const uint64_t empty = std::numeric_limits<uint64_t>::max();
+            values.assign(K, empty);
+            for(uint64_t shingle : shingles){
+                uint64_t h = splitmix64(shingle);
+                size_t bin = (h >> 32) % K;
+                values[bin] = std::min(values[bin], h);
+            }
+            // rotation densification: an empty bin takes the value of the next non-empty bin
+            size_t firstFilled = K;
+            for(size_t b=0; b<K; b++){
+                if(values[b] != empty){
+                    firstFilled = b;
+                    break;
+                }
+            }
+            if(firstFilled < K){
+                uint64_t next = values[firstFilled];
+                uint64_t distance = 0;
+                for(size_t step=0; step<K; step++){
+                    size_t b = (firstFilled + K - step) % K; // walk backwards around the ring
+                    if(values[b] == empty){
+                        values[b] = splitmix64(next + ++distance); // the offset keeps copies of one bin distinct
+                    } else {
+                        next = values[b];
+                        distance = 0;
+                    }
+                }
+            }
+            dirty = false;
+        }
+
+        /**
+         * @brief Estimated Jaccard similarity of two sketches (fraction of equal bins).
+         */
+        static float similarity(const MinHashSketch& a, const MinHashSketch& b){
+            if(a.values.size() != b.values.size() || a.values.empty()){
+                throw std::invalid_argument("sketches must have the same number of bins");
+            }
+            size_t equal = 0;
+            for(size_t i=0; i<a.values.size(); i++){
+                equal += a.values[i] == b.values[i];
+            }
+            return static_cast<float>(equal) / a.values.size();
+        }
+};
+
+/**
+ * @struct DiversityStats
+ * @brief Population diversity estimated from MinHash sketches.
+ */
+struct DiversityStats {
+    float meanSimilarity = 0; /**< estimated mean pairwise Jaccard similarity of the networks */
+    float diversity = 0; /**< 1 - meanSimilarity */
+    size_t clusters = 0; /**< groups of networks linked by a shared LSH band of their sketches */
+    float duplicateRatio = 0; /**< fraction of networks whose sketch equals an earlier network's sketch */
+    size_t recomputed = 0; /**< sketches rebuilt for this report (dirty individuals) */
+};
+
+/**
+ * @brief Diversity statistics of a set of sketches in O(n·K).
+ *
+ * @details
+ * - meanSimilarity: for every bin the number of equal pairs is sum_v c_v (c_v - 1) / 2
+ *   over the values v of the bin, so the mean over all pairs needs no pair comparison.
+ * - clusters: the K bins are split into nBands bands; networks that agree on all bins of
+ *   a band are linked (union-find), and the connected components are counted.
+ * - duplicateRatio: (n - number of distinct sketches) / n.
+ *
+ * @param sketches built sketches with the same number of bins
+ * @param nBands number of LSH bands (must divide K)
+ */
+inline DiversityStats sketchDiversity(const std::vector<const MinHashSketch*>& sketches, size_t nBands){
+    DiversityStats stats;
+    size_t n = sketches.size();
+    if(n == 0){
+        return stats;
+    }
+    size_t K = sketches[0]->values.size();
+    if(nBands == 0 || K % nBands != 0){
+        throw std::invalid_argument("nBands must divide the number of bins K");
+    }
+    for(const MinHashSketch* s : sketches){
+        if(s->values.size() != K){
+            throw std::invalid_argument("sketches must have the same number of bins");
+        }
+    }
+
+    if(n > 1){
+        double equalPairs = 0;
+        std::unordered_map<uint64_t, size_t> counts;
+        for(size_t b=0; b<K; b++){
+            counts.clear();
+            for(const MinHashSketch* s : sketches){
+                counts[s->values[b]]++;
+            }
+            for(const auto& [value, c] : counts){
+                equalPairs += 0.5 * static_cast<double>(c) * (c - 1);
+            }
+        }
+        double pairs = 0.5 * static_cast<double>(n) * (n - 1);
+        stats.meanSimilarity = equalPairs / (pairs * K);
+    } else {
+        stats.meanSimilarity = 1;
+    }
+    stats.diversity = 1 - stats.meanSimilarity;
+
+    std::vector<size_t> parent(n);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&](size_t x){
+        while(parent[x] != x){
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    };
+    size_t width = K / nBands;
+    std::unordered_map<uint64_t, size_t> bucket; // band key -> first network
+    for(size_t band=0; band<nBands; band++){
+        bucket.clear();
+        for(size_t i=0; i<n; i++){
+            uint64_t key = splitmix64(band);
+            for(size_t b=band*width; b<(band+1)*width; b++){
+                key = splitmix64(key ^ sketches[i]->values[b]);
+            }
+            auto [it, inserted] = bucket.emplace(key, i);
+            if(!inserted){
+                parent[find(i)] = find(it->second);
+            }
+        }
+    }
+    for(size_t i=0; i<n; i++){
+        stats.clusters += find(i) == i;
+    }
+
+    std::unordered_map<uint64_t, std::vector<size_t>> whole; // full sketch hash -> networks
+    size_t duplicates = 0;
+    for(size_t i=0; i<n; i++){
+        uint64_t key = 0;
+        for(uint64_t v : sketches[i]->values){
+            key = splitmix64(key ^ v);
+        }
+        auto& same = whole[key];
+        bool duplicate = false;
+        for(size_t j : same){
+            if(sketches[j]->values == sketches[i]->values){
+                duplicate = true;
+                break;
+            }
+        }
+        if(duplicate){
+            duplicates++;
+        } else {
+            same.push_back(i);
+        }
+    }
+    stats.duplicateRatio = static_cast<float>(duplicates) / n;
+    return stats;
+}
+
+#endif
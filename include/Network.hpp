@@ -1,15 +1,29 @@
 #ifndef NETWORK_HPP
 #define NETWORK_HPP
 /// \cond INTERNAL
+#include <algorithm>
 #include <cmath>
+#include "Aggregation.hpp"
+#include "CrossValidation.hpp"
+#include "DecisionBuffer.hpp"
+#include "DecisionCache.hpp"
+#include "FitnessPlugin.h"
+#include "Metrics.hpp"
+#include "MinHash.hpp"
 #include <iostream>
+#include <memory>
 #include <random>
+#include <unordered_map>
 #include <utility>
 #include <vector>
+#include "Backtest.hpp"
 #include "Cartpole.hpp"
+#include "Data.hpp"
 #include "Node.hpp"
 #include "Fractal.hpp"
-#include "GymnasiumWrapper.hpp"
+#include "SeedHistory.hpp"
+#include "Streaming.hpp"
+#include "Environment.hpp"
 /// \endcond
 
 /**
@@ -61,16 +75,25 @@ class Network {
         float fitness = std::numeric_limits<float>::lowest(); /**< Fitness value of the network (initialized to lowest possible value) */
         float lastFitness = std::numeric_limits<float>::lowest(); /**< last Fitness value from episode (used for analysis) */ 
         bool invalid = false; /**< Flag to indicate invalid individuals (e.g., exceeding judgment limits) */
+        bool truncated = false; /**< True if the last episode was cut short by an EpisodeBound (see fitGymnasium()) */
         int currentNodeID; /**< ID of the currently active node during network traversal */
         int nConsecutiveP; /**< Counter for consecutive processing nodes encountered */
         int nUsedNodes; /**< Number of nodes that have been used during network traversal */
         int nBest = 0; /**< counter for n best times of an individual during evolution */
         std::vector<int> decisions; /**< Sequence of decisions made during network execution */
+        DecisionBuffer compactDecisions; /**< bit-packed decisions of traversePathCompact() */
         std::vector<float> fitnessValues = {}; /** placeholder for storing multiple fitness values */
         int traverseCounter = 0; /**< Counter for how many times the network has been traversed (used for analysis) */
         size_t nCrossovers = 0; /**< Counter for how many times the network has been involved in crossover (used for analysis) */
         std::vector<float> objectives = {}; 
+        std::vector<float> behavior; /**< behaviour descriptor for novelty search, e.g. the final observation of fitGymnasium() (see Population::noveltyObjective()) */
         std::vector<float> lastStepRewards = {};
+        SeedHistory seedHistory; /**< returns of the last episodes, inherited through selection (see Population::gymnasiumSeedHistory()) */
+        StreamState streamState; /**< checkpoint for incremental fitness on a StreamWindow (see fitStreamingAccuracy()) */
+        MinHashSketch sketch; /**< MinHash sketch of the reachable structure, rebuilt lazily by minHash() */
+        size_t cachedGenomeBytes = 0; /**< result of the last genomeBytes() */
+        bool genomeBytesDirty = true; /**< true if genomeBytes() must be recomputed (set by genomeChanged()) */
+        DecisionCache decisionCache; /**< memo of judgment chains for deployment, disabled by default (see setDecisionCache()) */
 
         /** @endcond */
 
@@ -233,6 +256,107 @@ class Network {
             }
         }
 
+        /**
+         * @brief Traverses the network for a complete dataset and streams every decision into a sink.
+         *
+         * @details
+         * Same traversal as traversePath(), but nothing is stored: sink(row, decision, valid)
+         * is called once per row. On rows where dMax is exceeded valid is false and decision
+         * is 0; the traversal continues with the next row as in traversePath().
+         *
+         * @tparam Sink Callable with signature void(size_t row, int decision, bool valid)
+         * @param X Feature matrix where each inner vector represents one sample
+         * @param dMax Maximum number of consecutive judgment nodes allowed per decision
+         * @param sink Receiver of the decisions
+         */
+        template <typename Sink>
+        void traversePath(
+                const std::vector<std::vector<float>>& X,
+                int dMax,
+                Sink&& sink
+                ){
+            clearUsedNodes();
+            currentNodeID = startNode.edges[0];
+            innerNodes[currentNodeID].used = true;
+            innerNodes[currentNodeID].traverseCounter += 1;
+            nConsecutiveP = 0;
+            invalid = false;
+            for(size_t i=0; i<X.size(); i++){
+                int dec = decisionAndNextNode(X[i], dMax);
+                if(dec == std::numeric_limits<int>::lowest()){
+                    sink(i, 0, false);
+                } else {
+                    sink(i, dec, true);
+                }
+            }
+        }
+
+        /**
+         * @brief Traverses the network for a complete dataset and stores the decisions bit-packed.
+         *
+         * @details
+         * Like traversePath(), but the decisions are stored in compactDecisions with
+         * DecisionBuffer::bitsFor(pnf) bits each (e.g. 1 bit for pnf = 2) instead of an int,
+         * and invalid rows are listed explicitly. The member decisions is cleared.
+         *
+         * @param X Feature matrix where each inner vector represents one sample
+         * @param dMax Maximum number of consecutive judgment nodes allowed per decision
+         */
+        void traversePathCompact(
+                const std::vector<std::vector<float>>& X,
+                int dMax
+                ){
+            decisions.clear();
+            compactDecisions.reset(pnf);
+            compactDecisions.reserve(X.size());
+            traversePath(X, dMax, [&](size_t, int dec, bool valid){
+                if(valid){
+                    compactDecisions.push_back(dec);
+                } else {
+                    compactDecisions.pushInvalid();
+                }
+            });
+        }
+
+        /**
+         * @brief Traverses the network for a complete dataset and writes the decisions into a buffer.
+         *
+         * @details
+         * Same traversal as traversePath(), but the decisions are written into caller-owned
+         * memory (e.g. one row of a population-wide decision matrix) instead of the member
+         * decisions. If the network becomes invalid (dMax exceeded), the remaining entries
+         * from the invalid row on are set to -1.
+         *
+         * @tparam T Integer type of the buffer (narrow types such as int8_t are sufficient for small pnf)
+         * @param X Feature matrix where each inner vector represents one sample
+         * @param dMax Maximum number of consecutive judgment nodes allowed per decision
+         * @param out Buffer with room for X.size() decisions
+         */
+        template <typename T>
+        void traversePathInto(
+                const std::vector<std::vector<float>>& X,
+                int dMax,
+                T* out
+                ){
+            clearUsedNodes();
+            currentNodeID = startNode.edges[0];
+            innerNodes[currentNodeID].used = true;
+            innerNodes[currentNodeID].traverseCounter += 1;
+            nConsecutiveP = 0;
+            invalid = false;
+            size_t i = 0;
+            for(; i<X.size(); i++){
+                int dec = decisionAndNextNode(X[i], dMax);
+                if(invalid == true){
+                    break;
+                }
+                out[i] = static_cast<T>(dec);
+            }
+            for(; i<X.size(); i++){
+                out[i] = -1;
+            }
+        }
+
         /**
          * @brief Makes a single decision based on input data and transitions to the next node.
          * 
@@ -283,6 +407,9 @@ class Network {
                 nConsecutiveP ++;
 
             } else if (innerNodes[currentNodeID].type == "J"){
+                if(decisionCache.enabled()){
+                    return cachedJudgmentChain(data, dMax);
+                }
                 nConsecutiveP = 0;
                 while(innerNodes[currentNodeID].type == "J"){
                     // update currentNodeID to next node
@@ -309,6 +436,88 @@ class Network {
             return dec;
         }
 
+        /**
+         * @brief Enables (capacity > 0) or disables (0) the decision cache.
+         *
+         * @details
+         * With the cache, decisionAndNextNode() looks up the judgment chain of the current
+         * node under the quantised observation (see DecisionCache) and only traverses it on
+         * a miss. Decisions, the next node, nConsecutiveP, invalid and traverseCounter are
+         * identical to the uncached traversal; on a hit only the reached node is marked as
+         * used, not the judgment nodes in between. Meant for deployed controllers with
+         * repeating observations; during evolution the genome changes every generation
+         * and the cache only costs time.
+         *
+         * @warning The cache is only rebuilt after genomeChanged(). The genetic operators and
+         * setAllNodeBoundaries() call it, but direct edits of innerNodes or startNode (e.g. the
+         * edges or boundaries of a node) must call genomeChanged() before the next traversal,
+         * or cached chains of the old genome are returned. The Python setters of
+         * Network.innerNodes and Network.startNode call it; in-place edits such as
+         * net.startNode.edges = [...] do not.
+         *
+         * @param capacity number of cache slots
+         */
+        void setDecisionCache(size_t capacity){
+            decisionCache = DecisionCache(capacity);
+        }
+
+        /**
+         * @brief Judgment chain of decisionAndNextNode() through the decision cache.
+         */
+        template <typename dataContainer>
+        int cachedJudgmentChain(const dataContainer& data, int dMax){
+            if(!decisionCache.matches(dMax)){
+                decisionCache.prepare(innerNodes, dMax);
+            }
+            int start = currentNodeID;
+            bool cacheable = decisionCache.encode(data);
+            if(cacheable){
+                if(const DecisionCache::Entry* hit = decisionCache.find(start)){
+                    currentNodeID = hit->next;
+                    innerNodes[currentNodeID].used = true;
+                    traverseCounter += hit->steps;
+                    innerNodes[currentNodeID].traverseCounter = traverseCounter;
+                    nConsecutiveP = hit->invalid ? 0 : 1;
+                    if(hit->invalid){
+                        invalid = true;
+                        return std::numeric_limits<int>::lowest();
+                    }
+                    return hit->decision;
+                }
+            }
+            DecisionCache::Entry entry;
+            int counterBefore = traverseCounter;
+            nConsecutiveP = 0;
+            int dSum = 0;
+            while(innerNodes[currentNodeID].type == "J" && !entry.invalid){
+                double v = data[innerNodes[currentNodeID].f];
+                int judgeResult = innerNodes[currentNodeID].judge(v);
+                currentNodeID = innerNodes[currentNodeID].edges[judgeResult];
+                innerNodes[currentNodeID].used = true;
+                traverseCounter ++;
+                innerNodes[currentNodeID].traverseCounter = traverseCounter;
+                dSum ++;
+                entry.invalid = dSum >= dMax;
+            }
+            if(entry.invalid){
+                invalid = true;
+                entry.decision = std::numeric_limits<int>::lowest();
+            } else {
+                entry.decision = innerNodes[currentNodeID].f;
+                currentNodeID = innerNodes[currentNodeID].edges[0];
+                innerNodes[currentNodeID].used = true;
+                traverseCounter ++;
+                innerNodes[currentNodeID].traverseCounter = traverseCounter;
+                nConsecutiveP ++;
+            }
+            entry.next = currentNodeID;
+            entry.steps = traverseCounter - counterBefore;
+            if(cacheable){
+                decisionCache.store(start, entry);
+            }
+            return entry.decision;
+        }
+
 
         /**
          * @brief Initializes the network state for a new path traversal. 
@@ -380,6 +589,20 @@ class Network {
                 int dMax,
                 int penalty
                 ){
+            fitAccuracyRows([&](size_t i) -> const std::vector<float>& { return X[i]; }, y, dMax);
+        }
+
+        /**
+         * @brief Accuracy loop of fitAccuracy() over any row accessor.
+         *
+         * @tparam RowAt Callable with signature row(size_t i) returning the container passed
+         *  to decisionAndNextNode() for row i
+         * @param rowAt row accessor
+         * @param y Target labels, one per row
+         * @param dMax Maximum consecutive judgment nodes allowed per decision
+         */
+        template <typename RowAt>
+        void fitAccuracyRows(RowAt&& rowAt, const std::vector<int>& y, int dMax){
 
             clearUsedNodes();
             currentNodeID = startNode.edges[0];
@@ -390,8 +613,7 @@ class Network {
             float correct = 0;
 
             for(int i=0; i<y.size(); i++){
-                int  dSum = 0; // to prevent dead-looks 
-                dec = decisionAndNextNode(X[i], dMax);
+                dec = decisionAndNextNode(rowAt(i), dMax);
                 if(invalid == true){
                     fitness = 0;
                     break;
@@ -405,8 +627,513 @@ class Network {
                 fitness = correct / y.size();
             }
         }
+
+        /**
+         * @brief Evaluates network fitness with a classification metric from streaming confusion counts.
+         *
+         * @details
+         * The confusion counts are updated during the traversal (see ConfusionAccumulator),
+         * so no decisions are stored. Invalid networks (dMax exceeded) receive fitness 0.
+         *
+         * @param X Feature matrix where each inner vector represents one sample
+         * @param y Target labels in [0, nClasses) for each row of X
+         * @param nClasses Number of classes
+         * @param dMax Maximum consecutive judgment nodes allowed per decision
+         * @param metric "accuracy", "balancedAccuracy", "macroF1" or "kappa"
+         * @param confusion Optional accumulator that receives the confusion counts
+         */
+        void fitClassification(
+                const std::vector<std::vector<float>>& X,
+                const std::vector<int>& y,
+                size_t nClasses,
+                int dMax,
+                const std::string& metric,
+                ConfusionAccumulator* confusion = nullptr
+                ){
+            clearUsedNodes();
+            restartTraversal();
+            ConfusionAccumulator counts(nClasses);
+            for(size_t i=0; i<y.size(); i++){
+                int dec = decisionAndNextNode(X[i], dMax);
+                if(invalid == true){
+                    break;
+                }
+                counts.update(y[i], dec);
+            }
+            fitness = invalid ? 0 : counts.score(metric);
+            if(confusion != nullptr){
+                *confusion = counts;
+            }
+        }
+
+        /**
+         * @brief Evaluates network fitness using classification accuracy on a Data object with derived features.
+         *
+         * @details
+         * Same as fitAccuracy() for a feature matrix, but the rows are read through a
+         * Data::FeatureCursor. Judgment nodes with a function f behind the columns of X
+         * read the derived features of data (lags, differences, rolling statistics, ratios),
+         * which are computed during the traversal instead of being materialised.
+         *
+         * @param data Data object with member X and optional derived features
+         * @param y Target labels vector corresponding to each row of data.X
+         * @param dMax Maximum consecutive judgment nodes allowed per decision (prevents infinite loops)
+         * @param penalty Not applied; the parameter keeps the signature of fitAccuracy() for a feature matrix
+         *
+         * @see Data::addLagFeature(), Data::FeatureCursor
+         */
+        void fitAccuracy(
+                const Data& data,
+                const std::vector<int>& y,
+                int dMax,
+                [[maybe_unused]] int penalty
+                ){
+            Data::FeatureCursor cursor(data);
+            fitAccuracyRows([&](size_t i) -> const Data::FeatureCursor& { cursor.seek(i); return cursor; }, y, dMax);
+        }
+
+        /**
+         * @brief Evaluates the network as a trading rule with a backtest over a returns column.
+         *
+         * @details
+         * The decision of each row (function f of the reached processing node) is mapped to a
+         * position and consumed on the fly by a BacktestAccumulator, so no decisions buffer is
+         * stored. The position decided at row t is held over returns[t], i.e. returns[t] must be
+         * the return realised after the features of row t are known (e.g. the next bar's return).
+         *
+         * @param X Feature matrix (rows are time steps, columns are features)
+         * @param returns Asset return per row of X
+         * @param positions Position per decision (positions[f] for processing node function f).
+         *  If empty, the decision itself is used as position.
+         * @param dMax Maximum consecutive judgment nodes allowed per decision (prevents infinite loops)
+         * @param worstFitness Fitness value assigned if the network becomes invalid (dMax exceeded)
+         * @param cost Transaction cost per unit of turnover
+         * @param metric Fitness metric: "return", "sharpe" or "calmar" (see BacktestAccumulator::score())
+         * @param periodsPerYear Rows per year used to annualise the Sharpe ratio
+         *
+         * @post fitness contains the chosen metric
+         * @post fitnessValues contains {net return, Sharpe ratio, max drawdown, turnover}
+         */
+        void fitBacktest(
+                const std::vector<std::vector<float>>& X,
+                const std::vector<float>& returns,
+                const std::vector<float>& positions,
+                int dMax,
+                float worstFitness,
+                float cost = 0,
+                const std::string& metric = "sharpe",
+                float periodsPerYear = 252
+                ){
+
+            clearUsedNodes();
+            currentNodeID = startNode.edges[0];
+            innerNodes[currentNodeID].used = true;
+            innerNodes[currentNodeID].traverseCounter += 1;
+            nConsecutiveP = 0;
+            invalid = false;
+            BacktestAccumulator backtest(cost);
+
+            for(size_t i=0; i<returns.size(); i++){
+                int dec = decisionAndNextNode(X[i], dMax);
+                if(invalid == true){
+                    fitness = worstFitness;
+                    fitnessValues.clear();
+                    return;
+                }
+                double position = positions.empty() ? dec : positions[dec];
+                backtest.update(position, returns[i]);
+            }
+
+            fitness = backtest.score(metric, periodsPerYear);
+            fitnessValues = {
+                static_cast<float>(backtest.netReturn()),
+                static_cast<float>(backtest.sharpe(periodsPerYear)),
+                static_cast<float>(backtest.getMaxDrawdown()),
+                static_cast<float>(backtest.getTurnover())
+            };
+        }
+
+        /**
+         * @brief Restarts the traversal at the start node without clearing the node usage flags.
+         *
+         * @details
+         * Used at the boundaries of independent series, where the traversal state must be reset
+         * while the used flags keep accumulating over all series.
+         */
+        void restartTraversal(){
+            currentNodeID = startNode.edges[0];
+            innerNodes[currentNodeID].used = true;
+            innerNodes[currentNodeID].traverseCounter += 1;
+            nConsecutiveP = 0;
+            invalid = false;
+        }
+
+        /**
+         * @brief Evaluates classification accuracy on several independent series.
+         *
+         * @details
+         * The rows of X contain all series back to back; series s occupies the rows
+         * [offsets[s], offsets[s+1]). The traversal restarts at the start node at each
+         * series boundary (see restartTraversal()). A series on which the network becomes
+         * invalid (dMax exceeded) scores 0.
+         *
+         * @param X Feature matrix of all series
+         * @param y Target labels per row of X
+         * @param offsets Series boundaries (number of series + 1 values, see checkSeriesOffsets())
+         * @param dMax Maximum consecutive judgment nodes allowed per decision
+         * @param aggregation Aggregation of the per-series scores: "mean", "worst" or "quantile"
+         * @param q Quantile used by "quantile"
+         *
+         * @post fitnessValues contains the accuracy per series
+         * @post objectives contains {mean, worst} of the per-series accuracies
+         * @post fitness contains the aggregated accuracy
+         */
+        void fitAccuracyMultiSeries(
+                const std::vector<std::vector<float>>& X,
+                const std::vector<int>& y,
+                const std::vector<size_t>& offsets,
+                int dMax,
+                const std::string& aggregation = "mean",
+                float q = 0.5
+                ){
+            clearUsedNodes();
+            fitnessValues.clear();
+            bool anyInvalid = false;
+            for(size_t s=0; s+1<offsets.size(); s++){
+                restartTraversal();
+                float correct = 0;
+                for(size_t i=offsets[s]; i<offsets[s+1]; i++){
+                    int dec = decisionAndNextNode(X[i], dMax);
+                    if(invalid == true){
+                        break;
+                    }
+                    if(dec == y[i]){
+                        correct += 1;
+                    }
+                }
+                size_t n = offsets[s+1] - offsets[s];
+                anyInvalid = anyInvalid || invalid;
+                fitnessValues.push_back(invalid || n == 0 ? 0 : correct / n);
+            }
+            invalid = anyInvalid;
+            setMultiSeriesFitness(aggregation, q);
+        }
+
+        /**
+         * @brief Evaluates the network as a trading rule on several independent series (instruments).
+         *
+         * @details
+         * Like fitBacktest(), but the backtest restarts flat at every series boundary
+         * (see fitAccuracyMultiSeries() for the layout of X). A series on which the network
+         * becomes invalid scores worstFitness.
+         *
+         * @param X Feature matrix of all series
+         * @param returns Asset return per row of X
+         * @param offsets Series boundaries (number of series + 1 values)
+         * @param positions Position per decision (empty = decision is the position)
+         * @param dMax Maximum consecutive judgment nodes allowed per decision
+         * @param worstFitness Score of a series on which the network becomes invalid
+         * @param cost Transaction cost per unit of turnover
+         * @param metric Per-series metric: "return", "sharpe" or "calmar"
+         * @param periodsPerYear Rows per year used to annualise the Sharpe ratio
+         * @param aggregation Aggregation of the per-series scores: "mean", "worst" or "quantile"
+         * @param q Quantile used by "quantile"
+         *
+         * @post fitnessValues contains the metric per series
+         * @post objectives contains {mean, worst} of the per-series metrics
+         * @post fitness contains the aggregated metric
+         */
+        void fitBacktestMultiSeries(
+                const std::vector<std::vector<float>>& X,
+                const std::vector<float>& returns,
+                const std::vector<size_t>& offsets,
+                const std::vector<float>& positions,
+                int dMax,
+                float worstFitness,
+                float cost = 0,
+                const std::string& metric = "sharpe",
+                float periodsPerYear = 252,
+                const std::string& aggregation = "mean",
+                float q = 0.5
+                ){
+            clearUsedNodes();
+            fitnessValues.clear();
+            bool anyInvalid = false;
+            for(size_t s=0; s+1<offsets.size(); s++){
+                restartTraversal();
+                BacktestAccumulator backtest(cost);
+                for(size_t i=offsets[s]; i<offsets[s+1]; i++){
+                    int dec = decisionAndNextNode(X[i], dMax);
+                    if(invalid == true){
+                        break;
+                    }
+                    backtest.update(positions.empty() ? dec : positions[dec], returns[i]);
+                }
+                anyInvalid = anyInvalid || invalid;
+                fitnessValues.push_back(invalid ? worstFitness : backtest.score(metric, periodsPerYear));
+            }
+            invalid = anyInvalid;
+            setMultiSeriesFitness(aggregation, q);
+        }
+
+        /**
+         * @brief Evaluates classification accuracy on the folds of a cross-validation.
+         *
+         * @details
+         * For each fold the traversal restarts at the start node and visits the rows of the
+         * selected part in ascending order directly in X (no copies). A fold on which the
+         * network becomes invalid scores 0.
+         *
+         * @param X Feature matrix of the whole data set
+         * @param y Target labels per row of X
+         * @param folds Fold index sets (see kFoldSplits(), walkForwardSplits())
+         * @param dMax Maximum consecutive judgment nodes allowed per decision
+         * @param part Evaluated part of every fold: "train" or "test"
+         * @param aggregation Aggregation of the per-fold scores: "mean", "worst" or "quantile"
+         * @param q Quantile used by "quantile"
+         *
+         * @post fitnessValues contains the accuracy per fold
+         * @post objectives contains {mean, worst} of the per-fold accuracies
+         * @post fitness contains the aggregated accuracy
+         */
+        void fitAccuracyFolds(
+                const std::vector<std::vector<float>>& X,
+                const std::vector<int>& y,
+                const std::vector<Fold>& folds,
+                int dMax,
+                const std::string& part = "test",
+                const std::string& aggregation = "mean",
+                float q = 0.5
+                ){
+            clearUsedNodes();
+            fitnessValues.clear();
+            bool anyInvalid = false;
+            for(const Fold& fold : folds){
+                const std::vector<size_t>& rows = fold.rows(part);
+                restartTraversal();
+                float correct = 0;
+                for(size_t r : rows){
+                    int dec = decisionAndNextNode(X[r], dMax);
+                    if(invalid == true){
+                        break;
+                    }
+                    if(dec == y[r]){
+                        correct += 1;
+                    }
+                }
+                anyInvalid = anyInvalid || invalid;
+                fitnessValues.push_back(invalid || rows.empty() ? 0 : correct / rows.size());
+            }
+            invalid = anyInvalid;
+            setMultiSeriesFitness(aggregation, q);
+        }
+
+        /**
+         * @brief Evaluates network fitness with a native fitness kernel.
+         *
+         * @details
+         * The kernel receives the decision of every row (see FitnessPlugin.h for the call
+         * sequence). If the network becomes invalid (dMax exceeded), the kernel is not
+         * finished and the fitness is set to worstFitness. The kernel state is destroyed
+         * even if consume() or finish() throws.
+         *
+         * @param X Feature matrix where each inner vector represents one sample
+         * @param kernel Function table of the kernel (see FitnessRegistry)
+         * @param targets Row-major target matrix passed to the kernel (may be nullptr)
+         * @param nCols Number of columns of targets
+         * @param dMax Maximum consecutive judgment nodes allowed per decision
+         * @param worstFitness Fitness of an invalid network
+         */
+        void fitNative(
+                const std::vector<std::vector<float>>& X,
+                const FracneticsFitnessKernel& kernel,
+                const float* targets,
+                size_t nCols,
+                int dMax,
+                float worstFitness
+                ){
+            clearUsedNodes();
+            restartTraversal();
+            auto destroy = [&kernel](void* state){ kernel.destroy(state); };
+            std::unique_ptr<void, decltype(destroy)> state(kernel.create(kernel.userData, targets, X.size(), nCols), destroy);
+            for(size_t i=0; i<X.size(); i++){
+                int dec = decisionAndNextNode(X[i], dMax);
+                if(invalid == true){
+                    break;
+                }
+                kernel.consume(state.get(), i, dec);
+            }
+            fitness = invalid ? worstFitness : kernel.finish(state.get());
+        }
+
+        /**
+         * @brief Aggregates the per-series (or per-fold) scores in fitnessValues into fitness and objectives.
+         */
+        void setMultiSeriesFitness(const std::string& aggregation, float q){
+            fitness = aggregateScores(fitnessValues, aggregation, q);
+            objectives = {
+                aggregateScores(fitnessValues, "mean"),
+                aggregateScores(fitnessValues, "worst")
+            };
+        }
+
+        /**
+         * @brief Evaluates network fitness incrementally on a sliding window of streaming data.
+         *
+         * @details
+         * The accuracy on the rows of the window is maintained in streamState:
+         *
+         * 1. **Incremental update** (valid checkpoint):
+         *    - Contributions of rows that expired from the window are subtracted
+         *    - The traversal continues from the checkpointed node and only the rows
+         *      appended since the last call are evaluated
+         * 2. **Re-anchoring** (full evaluation of the window from the start node):
+         *    - If the checkpoint is invalid (new individual, genome changed, see genomeChanged())
+         *    - If the network became invalid (dMax exceeded)
+         *    - If reanchorInterval rows have been evaluated incrementally since the last anchor
+         *    - If window does not continue the checkpoint: all checkpointed rows expired, or the
+         *      window ends before the next row or starts before the first checkpointed row
+         *      (a new or reset window)
+         *
+         * Between two anchors the traversal state carries over from rows that already left
+         * the window, so the fitness can deviate slightly from a full evaluation of the window.
+         * Re-anchoring bounds this drift; reanchorInterval = 0 always evaluates from scratch.
+         *
+         * @param window sliding window with the current rows and labels
+         * @param dMax Maximum consecutive judgment nodes allowed per decision (prevents infinite loops)
+         * @param reanchorInterval Number of incrementally evaluated rows after which the window is evaluated from scratch
+         *
+         * @post fitness contains the accuracy on the window rows (0 if the network is invalid)
+         */
+        void fitStreamingAccuracy(
+                const StreamWindow& window,
+                int dMax,
+                size_t reanchorInterval
+                ){
+            StreamState& state = streamState;
+            bool anchor = state.valid == false ||
+                          state.rowsSinceAnchor >= reanchorInterval ||
+                          state.nextRow < window.firstRow() || // all rows since the checkpoint expired
+                          state.nextRow > window.endRow() ||   // a new or reset window
+                          state.firstRow > window.firstRow();  // the window starts before the checkpoint
+
+            if(anchor){
+                clearUsedNodes();
+                currentNodeID = startNode.edges[0];
+                innerNodes[currentNodeID].used = true;
+                innerNodes[currentNodeID].traverseCounter += 1;
+                nConsecutiveP = 0;
+                state.contributions.clear();
+                state.correct = 0;
+                state.firstRow = window.firstRow();
+                state.nextRow = window.firstRow();
+                state.rowsSinceAnchor = 0;
+            } else {
+                while(state.firstRow < window.firstRow() && !state.contributions.empty()){ // expire old rows
+                    state.correct -= state.contributions.front();
+                    state.contributions.pop_front();
+                    state.firstRow ++;
+                }
+                currentNodeID = state.currentNodeID;
+                nConsecutiveP = state.nConsecutiveP;
+            }
+            invalid = false;
+
+            for(size_t r = state.nextRow; r < window.endRow(); r++){
+                int dec = decisionAndNextNode(window.row(r), dMax);
+                if(invalid == true){
+                    fitness = 0;
+                    state.valid = false; // next update starts from scratch
+                    return;
+                }
+                uint8_t hit = dec == window.label(r) ? 1 : 0;
+                state.contributions.push_back(hit);
+                state.correct += hit;
+                if(anchor == false){
+                    state.rowsSinceAnchor ++;
+                }
+            }
+
+            state.nextRow = window.endRow();
+            state.currentNodeID = currentNodeID;
+            state.nConsecutiveP = nConsecutiveP;
+            state.valid = true;
+            fitness = state.contributions.empty() ? 0 : static_cast<float>(state.correct) / state.contributions.size();
+        }
+
+        /**
+         * @brief Invalidates all cached evaluation state after the genome has been modified.
+         *
+         * @details
+         * Called by the genetic operators of Population for every individual they touch.
+         * Custom operators that modify innerNodes or startNode directly should call it as well.
+         */
+        void genomeChanged(){
+            streamState.valid = false;
+            sketch.invalidate();
+            genomeBytesDirty = true;
+            decisionCache.invalidate();
+        }
         /** @endcond */
 
+        /**
+         * @brief MinHash sketch of the canonicalised reachable structure of the network.
+         *
+         * @details
+         * The nodes reachable from the start node are numbered in depth-first discovery
+         * order (following the edges in their stored order), so the numbering does not
+         * depend on the positions of the nodes in innerNodes. Every reachable edge gives
+         * one shingle (canonical source, its type and function, edge index, canonical
+         * target, its type and function); boundaries are not part of the structure.
+         *
+         * The sketch is only rebuilt if the genome changed since the last call (see
+         * genomeChanged()) or K differs, in O(E + K).
+         *
+         * @param K number of bins of the sketch
+         * @return the cached sketch
+         */
+        const MinHashSketch& minHash(size_t K = 64){
+            if(!sketch.dirty && sketch.values.size() == K){
+                return sketch;
+            }
+            std::vector<int> canonical(innerNodes.size(), -1);
+            std::vector<int> order;
+            std::vector<int> stack = {startNode.edges[0]};
+            while(!stack.empty()){
+                int id = stack.back();
+                stack.pop_back();
+                if(id < 0 || static_cast<size_t>(id) >= innerNodes.size() || canonical[id] >= 0){
+                    continue;
+                }
+                canonical[id] = order.size();
+                order.push_back(id);
+                const std::vector<int>& edges = innerNodes[id].edges;
+                for(auto it = edges.rbegin(); it != edges.rend(); ++it){ // first edge is visited first
+                    stack.push_back(*it);
+                }
+            }
+            auto label = [&](int id){
+                const Node& node = innerNodes[id];
+                return (static_cast<uint64_t>(node.type == "J") << 32) | static_cast<uint32_t>(node.f);
+            };
+            std::vector<uint64_t> shingles;
+            for(int id : order){
+                const Node& node = innerNodes[id];
+                uint64_t source = splitmix64((static_cast<uint64_t>(canonical[id]) << 32) ^ label(id));
+                for(size_t e=0; e<node.edges.size(); e++){
+                    int target = node.edges[e];
+                    if(target < 0 || static_cast<size_t>(target) >= innerNodes.size()){
+                        continue;
+                    }
+                    uint64_t shingle = splitmix64(source ^ (static_cast<uint64_t>(e) << 48));
+                    shingle = splitmix64(shingle ^ (static_cast<uint64_t>(canonical[target]) << 32) ^ label(target));
+                    shingles.push_back(shingle);
+                }
+            }
+            sketch.build(shingles, K);
+            return sketch;
+        }
+
 
         /**
          * @brief Evaluates network fitness using an OpenAI Gymnasium-compatible environment.
@@ -438,8 +1165,12 @@ class Network {
          *    - Maximum step limit reached
          *    - Network becomes invalid (exceeds dMax)
          *    - Too many consecutive processing nodes (exceeds maxConsecutiveP)
+         *    - The return can no longer reach bound.threshold (opt-in, sets truncated). The fitness
+         *      is then the best reachable return (EpisodeBound::best()) and lastFitness is
+         *      std::numeric_limits<float>::lowest(), as the episode has no final step.
          * 
-         * @param env GymEnvWrapper object providing the Gymnasium environment interface
+         * @tparam Env Environment type (see Environment.hpp), e.g. GymEnvWrapper for Python Gymnasium environments
+         * @param env Environment providing resetObservation() and stepAction()
          * @param dMax Maximum consecutive judgment nodes per decision (prevents infinite loops)
          * @param maxSteps Maximum number of environment steps per episode
          * @param maxConsecutiveP Maximum consecutive processing nodes allowed.
@@ -448,21 +1179,24 @@ class Network {
          * @param seed Random seed for environment initialization 
          * @param gamma discount factor of the rewards
          * @param newRun If true, resets network state for a new episode; if false, continues from current state (useful for multi-episode evaluation)
+         * @param bound Early termination bound (inactive by default, see EpisodeBound)
          * 
+         * @post behavior holds the last observation of the episode (for novelty search)
          * @warning The network must produce valid actions for the specific Gymnasium environment
          */
+        template <Environment Env>
         void fitGymnasium(
-            GymEnvWrapper& env,
+            Env& env,
             int dMax,
             int maxSteps,
             int maxConsecutiveP,
             int worstFitness,
             int seed,
-            bool newRun = true
+            bool newRun = true,
+            const EpisodeBound& bound = {}
             ){
 
-            auto reset_out = env.reset(seed=seed);// Initial observation for the episode
-            auto obs = reset_out[0].cast<std::vector<double>>();   
+            std::vector<double> obs = env.resetObservation(seed);// Initial observation for the episode
 
             if(newRun == true){
                 clearUsedNodes();
@@ -481,25 +1215,35 @@ class Network {
             fitness = 0;
             nConsecutiveP = 0;
             invalid = false;
+            truncated = false;
             bool done = false;
             int steps = 0;
 
             while(done == false){
+                if(bound.unreachable(fitness, maxSteps - steps)){
+                    truncated = true;
+                    fitness = bound.best(fitness, maxSteps - steps);
+                    lastFitness = std::numeric_limits<float>::lowest(); // the episode has no final step
+                    behavior.assign(obs.begin(), obs.end());
+                    return;
+                }
                 dec = decisionAndNextNode(obs, dMax);
 
                 if (invalid || nConsecutiveP > maxConsecutiveP){
                     fitness = worstFitness;
                     lastFitness = worstFitness;
+                    behavior.assign(obs.begin(), obs.end());
                     return;
                 }
 
-                auto result = env.step(dec);
-                obs = result[0].cast<std::vector<double>>(); 
-                fitness += result[1].cast<float>();
+                EnvironmentStep result = env.stepAction(dec);
+                obs = std::move(result.observation);
+                fitness += result.reward;
                 steps ++;
-                if(result[2].cast<bool>() || result[3].cast<bool>() || steps >= maxSteps) done = true; 
-                lastFitness = result[1].cast<float>();
+                if(result.terminated || result.truncated || steps >= maxSteps) done = true; 
+                lastFitness = result.reward;
             }
+            behavior.assign(obs.begin(), obs.end());
         }
                  
         /**
@@ -727,6 +1471,8 @@ class Network {
          * @param minF Vector of minimum feature values for each feature dimension (used for judgment node boundary initialization)
          * @param maxF Vector of maximum feature values for each feature dimension (used for judgment node boundary initialization)
          * @junk ratio of protected unused nodes (junk DNA). A value of 0.1 protects 10% of unused nodes.
+         * @param allowGrowth If false, the addition branch is replaced by the deletion branch
+         *  (used by Population to enforce a GenomeBudget)
          * 
          * @warning This method must be called bevore edgeMutation()! Reason: if edges are change 
          * by edgeMutation(), the node flag "used" is not guaranteed to be correct.
@@ -735,11 +1481,11 @@ class Network {
          * @post Node IDs are contiguous from 0 to innerNodes.size()-1
          * 
          */
-        void addDelNodes(std::vector<float>& minF, std::vector<float>& maxF, float junk, std::vector<int>& nFeatureValues){ 
+        void addDelNodes(std::vector<float>& minF, std::vector<float>& maxF, float junk, std::vector<int>& nFeatureValues, bool allowGrowth = true){ 
             std::bernoulli_distribution distributionBernoulliAdd(0.5);
             //float pnRatio = static_cast<float>(pnf) / static_cast<float>(pnf+jnf);
             std::bernoulli_distribution distributionBernoulliProcessingNode(pnRatio());
-            bool resultAdd = distributionBernoulliAdd(*generator);
+            bool resultAdd = distributionBernoulliAdd(*generator) && allowGrowth;
             countUsedNodes();
             for(int n=0; n<innerNodes.size(); n++){
                 if(resultAdd && // adding node
@@ -794,38 +1540,149 @@ class Network {
                         innerNodes.size() - nUsedNodes - 1 > innerNodes.size() * junk && // left: current junk size (unused nodes); right: allowed junk size 
                         innerNodes[n].used == false) // node is not used
                 {// deleting nodes
+                    deleteNode(n);
+                }
+            }
+            innerNodes.shrink_to_fit();
+        }
 
-                    for(auto& node : innerNodes){
-                        // adapting node IDs of innerNodes
-                        if(node.id > innerNodes[n].id){
-                            node.id -= 1; // set back node numbers for nodes greater deleted id 
-                        }
-                    }
+        /**
+         * @brief Deletes an inner node that is not the target of the start node.
+         *
+         * @details
+         * Node IDs and edges behind the deleted node are shifted down by one; edges that
+         * pointed to the deleted node are redirected to a random other node (see
+         * Node::changeEdge()). Used by addDelNodes() and pruneUnused() for unused nodes,
+         * for which the redirection does not change the decisions of the last traversal.
+         *
+         * @param n index of the node to delete
+         */
+        void deleteNode(int n){
+            for(auto& node : innerNodes){
+                // adapting node IDs of innerNodes
+                if(node.id > innerNodes[n].id){
+                    node.id -= 1; // set back node numbers for nodes greater deleted id 
+                }
+            }
 
-                    for(auto& node : innerNodes){ // for each node
+            for(auto& node : innerNodes){ // for each node
 
-                       // adapting node edges
-                        for(int& edge : node.edges){ // for each edge
+               // adapting node edges
+                for(int& edge : node.edges){ // for each edge
 
-                            if(edge > n){
-                                edge -= 1; // change edges to reset node ids 
-                            }else if(edge == n){ // change edge pointing to deleted node
-                                edge = node.changeEdge(innerNodes.size()-1, edge);
-                            }
-                        }
+                    if(edge > n){
+                        edge -= 1; // change edges to reset node ids 
+                    }else if(edge == n){ // change edge pointing to deleted node
+                        edge = node.changeEdge(innerNodes.size()-1, edge);
                     }
+                }
+            }
+
+            
+            // adapting start node edge; hint: no changeEdge() needed because a node connected 
+            // by a startnode ist always used. 
+            if(startNode.edges[0] > n){
+                startNode.edges[0] -= 1;
+            }
 
-                    
-                    // adapting start node edge; hint: no changeEdge() needed because a node connected 
-                    // by a startnode ist always used. 
-                    if(startNode.edges[0] > n){
-                        startNode.edges[0] -= 1;
+            innerNodes.erase(innerNodes.begin()+n);
+        }
+
+        /**
+         * @brief Removes all inner nodes that cannot be reached from the start node.
+         *
+         * @details
+         * Unreachable nodes are never traversed, so removing them does not change any
+         * decision. The remaining nodes keep their order; IDs and edges are renumbered.
+         *
+         * @return number of removed nodes
+         */
+        size_t pruneUnreachable(){
+            std::vector<char> reachable(innerNodes.size(), 0);
+            std::vector<int> stack = {startNode.edges[0]};
+            while(!stack.empty()){
+                int id = stack.back();
+                stack.pop_back();
+                if(id < 0 || static_cast<size_t>(id) >= innerNodes.size() || reachable[id]){
+                    continue;
+                }
+                reachable[id] = 1;
+                stack.insert(stack.end(), innerNodes[id].edges.begin(), innerNodes[id].edges.end());
+            }
+            std::vector<int> newIndex(innerNodes.size(), -1);
+            int kept = 0;
+            for(size_t i=0; i<innerNodes.size(); i++){
+                if(reachable[i]){
+                    newIndex[i] = kept++;
+                }
+            }
+            size_t removed = innerNodes.size() - kept;
+            if(removed == 0){
+                return 0;
+            }
+            std::vector<Node> remaining;
+            remaining.reserve(kept);
+            for(size_t i=0; i<innerNodes.size(); i++){
+                if(reachable[i]){
+                    remaining.push_back(std::move(innerNodes[i]));
+                    Node& node = remaining.back();
+                    node.id = newIndex[i];
+                    for(int& edge : node.edges){
+                        edge = newIndex[edge]; // targets of reachable nodes are reachable
                     }
+                }
+            }
+            startNode.edges[0] = newIndex[startNode.edges[0]];
+            innerNodes = std::move(remaining);
+            genomeChanged();
+            return removed;
+        }
+
+        /**
+         * @brief Deletes up to maxRemove nodes that were not used in the last traversal.
+         *
+         * @details
+         * Like the deletion branch of addDelNodes(), the decisions of the last traversal
+         * do not change. At least three inner nodes are kept, so that redirected edges
+         * always find a new target.
+         *
+         * @param maxRemove maximum number of nodes to delete
+         * @return number of deleted nodes
+         */
+        size_t pruneUnused(size_t maxRemove){
+            size_t removed = 0;
+            for(int n=innerNodes.size()-1; n>=0 && removed < maxRemove && innerNodes.size() > 3; n--){
+                if(!innerNodes[n].used && n != startNode.edges[0]){
+                    deleteNode(n);
+                    removed++;
+                }
+            }
+            if(removed > 0){
+                innerNodes.shrink_to_fit();
+                genomeChanged();
+            }
+            return removed;
+        }
 
-                    innerNodes.erase(innerNodes.begin()+n);
+        /**
+         * @brief Heap memory of the genome in bytes (nodes, edges, boundaries and parameters).
+         *
+         * @details
+         * The value is cached and only recomputed after genomeChanged(), so summing it over
+         * a population costs O(ni) plus O(nodes) per modified individual.
+         */
+        size_t genomeBytes(){
+            if(genomeBytesDirty){
+                size_t bytes = sizeof(Network) + innerNodes.capacity() * sizeof(Node);
+                for(const Node& node : innerNodes){
+                    bytes += node.edges.capacity() * sizeof(int) +
+                             node.boundaries.capacity() * sizeof(double) +
+                             node.productionRuleParameter.capacity() * sizeof(float);
                 }
+                cachedGenomeBytes = bytes;
+                genomeBytesDirty = false;
             }
-            innerNodes.shrink_to_fit();
+            return cachedGenomeBytes;
         }
         
         /**
@@ -1,8 +1,10 @@
 #ifndef NODE_HPP
 #define NODE_HPP
 #include <utility>
+#include <algorithm>
 #include <vector>
 #include <string>
+#include <memory>
 #include <random>
 #include "Fractal.hpp"
 #include <iostream>
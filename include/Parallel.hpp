@@ -0,0 +1,135 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file Parallel.hpp
+ * @brief Minimal parallel loop used to evaluate individuals concurrently.
+ */
+
+/**
+ * @brief Resolves the requested number of threads.
+ * @param nThreads requested number of threads (0 = number of hardware threads)
+ * @return number of threads to use (at least 1)
+ */
+inline unsigned int resolveThreads(unsigned int nThreads){
+    if(nThreads == 0){
+        nThreads = std::thread::hardware_concurrency();
+    }
+    return std::max(1u, nThreads);
+}
+
+/**
+ * @class ObjectMutex
+ * @brief Mutex that can be a member of a copyable class.
+ *
+ * @details
+ * The mutex guards one object, not its value: a copy gets a fresh, unlocked mutex
+ * and assignment leaves the mutex of the target untouched.
+ */
+class ObjectMutex {
+    public:
+        ObjectMutex() = default;
+        ObjectMutex(const ObjectMutex&) {}
+        ObjectMutex& operator=(const ObjectMutex&) { return *this; }
+
+        std::mutex& get() const { return mutex; } /**< underlying mutex */
+
+    private:
+        mutable std::mutex mutex;
+};
+
+/**
+ * @class ObjectFlag
+ * @brief Atomic boolean state that can be a member of a copyable class.
+ *
+ * @details
+ * Like ObjectMutex, the flag describes one object, not its value: a copy starts as
+ * false and assignment of the owner leaves the flag of the target untouched. Reads and
+ * writes are atomic, so the flag can be checked without holding the owner's mutex.
+ */
+class ObjectFlag {
+    public:
+        ObjectFlag() = default;
+        ObjectFlag(const ObjectFlag&) {}
+        ObjectFlag& operator=(const ObjectFlag&) { return *this; }
+
+        ObjectFlag& operator=(bool value){ flag.store(value); return *this; } /**< sets the flag */
+        operator bool() const { return flag.load(); } /**< reads the flag */
+
+    private:
+        std::atomic<bool> flag{false};
+};
+
+/**
+ * @brief Calls func(i) for all i in [0, n) on up to nThreads threads.
+ *
+ * @details
+ * Indices are handed out dynamically in chunks of the given size, so expensive
+ * individuals (large networks, long episodes) do not stall a whole thread block.
+ * The calling thread takes part in the work. If func throws, the remaining indices
+ * are skipped and the first exception is rethrown in the calling thread.
+ *
+ * @param n number of iterations
+ * @param nThreads number of threads (0 = number of hardware threads, 1 = serial)
+ * @param func callable with signature void(size_t)
+ * @param chunk number of consecutive indices a thread takes at once
+ *
+ * @warning func must only modify state owned by index i
+ */
+template <typename Func>
+void parallelFor(size_t n, unsigned int nThreads, Func&& func, size_t chunk = 1){
+    chunk = std::max<size_t>(1, chunk);
+    size_t nWorkers = std::min<size_t>(resolveThreads(nThreads), (n + chunk - 1) / chunk);
+    if(nWorkers <= 1){
+        for(size_t i=0; i<n; i++){
+            func(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto work = [&](){
+        while(!failed){
+            size_t begin = next.fetch_add(chunk);
+            if(begin >= n){
+                return;
+            }
+            size_t end = std::min(n, begin + chunk);
+            try {
+                for(size_t i=begin; i<end; i++){
+                    func(i);
+                }
+            } catch(...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if(!error){
+                    error = std::current_exception();
+                }
+                failed = true;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(nWorkers - 1);
+    for(size_t t=1; t<nWorkers; t++){
+        workers.emplace_back(work);
+    }
+    work();
+    for(auto& worker : workers){
+        worker.join();
+    }
+    if(error){
+        std::rethrow_exception(error);
+    }
+}
+
+#endif
@@ -1,15 +1,22 @@
 #ifndef POPULATION_HPP
 #define POPULATION_HPP
 #include <algorithm>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include <memory>
 #include <random>
+#include <sstream>
+#include <stdexcept>
 #include <unordered_set>
 #include <utility>
 #include <cmath>
+#include "BehaviorArchive.hpp"
 #include "Network.hpp"
-#include "GymnasiumWrapper.hpp"
+#include "FitnessRegistry.hpp"
+#include "GenomeBudget.hpp"
+#include "Parallel.hpp"
 
 /**
  * @class Population 
@@ -54,12 +61,20 @@ class Population {
         unsigned int pnf; /**< Number of processing node function types available */
         bool fractalJudgment; /**< Flag indicating whether judgment nodes use fractal-based edge patterns */
         std::vector<Network> individuals; /**< Vector containing all Network individuals in the population */
-        float bestFit; /**< Fitness value of the best individual in the current population */
+        float bestFit = 0; /**< Fitness value of the best individual in the current population */
         std::vector<int> indicesElite; /**< Indices of elite individuals (protected from mutation) */
         float meanFitness = 0; /**< Mean fitness across all individuals in the population */
-        float minFitness; /**< Minimum fitness value in the current population */
+        float minFitness = 0; /**< Minimum fitness value in the current population */
         int maxNetworkSize; 
         std::vector<int> nFeatureValues; /** stores the number of feature values */
+        unsigned int nThreads = 0; /**< Number of threads for data-based fitness evaluation (0 = all hardware threads, 1 = serial) */
+        size_t chunk = 1; /**< Number of consecutive individuals a thread takes at once in parallel evaluations (see parallelFor(), Autotuner) */
+        ObjectMutex mutex; /**< Serialises calls on this population from several (free-threaded) Python threads */
+        ObjectFlag evaluating; /**< True while an evaluation started by evaluateAsync() is not committed (atomic, see lockIdlePopulation()) */
+        ObjectFlag borrowed; /**< True while a PopulationView holds individuals of this population (atomic, see lockIdlePopulation()) */
+        SeedPool seedPool; /**< Anchor and rolling evaluation seeds (see rollSeedPool() and gymnasiumSeedHistory()) */
+        GenomeBudget budget; /**< Limits of the total genome size (inactive by default, see enforceBudget()) */
+        BudgetStats budgetStats; /**< Counters of the budget enforcement */
         /** @endcond */
 
         /** @name Constructor */
@@ -116,10 +131,127 @@ class Population {
             individuals.push_back(Network(generator,jn,jnf,pn,pnf,fractalJudgment,nFeatureValues));
         }
     }
+
+        /**
+         * @brief Constructs a population from individuals taken out of another population.
+         *
+         * @details
+         * The new population shares the random generator of parent and copies its settings
+         * (node counts and functions, nFeatureValues, maxNetworkSize, nThreads, chunk, seedPool, budget).
+         * Elite indices of parent are kept if the corresponding individual is part of the
+         * new population, given as the positions in parentIndices.
+         *
+         * @param parent population whose settings and generator are used
+         * @param _individuals individuals of the new population
+         * @param parentIndices position of each individual in parent (used to map the elite)
+         *
+         * @see copySubset(), PopulationView
+         */
+        Population(const Population& parent, std::vector<Network> _individuals, const std::vector<int>& parentIndices):
+            generator(parent.generator),
+            ni(_individuals.size()),
+            jn(parent.jn),
+            jnf(parent.jnf),
+            pn(parent.pn),
+            pnf(parent.pnf),
+            fractalJudgment(parent.fractalJudgment),
+            individuals(std::move(_individuals)),
+            bestFit(parent.bestFit),
+            meanFitness(parent.meanFitness),
+            minFitness(parent.minFitness),
+            maxNetworkSize(parent.maxNetworkSize),
+            nFeatureValues(parent.nFeatureValues),
+            nThreads(parent.nThreads),
+            chunk(parent.chunk),
+            seedPool(parent.seedPool),
+            budget(parent.budget)
+    {
+        for(int e : parent.indicesElite){
+            auto it = std::find(parentIndices.begin(), parentIndices.end(), e);
+            if(it != parentIndices.end()){
+                indicesElite.push_back(it - parentIndices.begin());
+            }
+        }
+    }
         /** @} */
 
         /** @name Member Functions */
         /** @{ */
+        /**
+         * @brief Copies selected individuals into a new, independent population.
+         *
+         * @details
+         * Only the selected individuals are copied (O(E) instead of copying the whole
+         * population), e.g. to render or validate the elite while the population keeps
+         * evolving. The copy shares the random generator (see Population(const Population&,
+         * std::vector<Network>, const std::vector<int>&)). To evaluate individuals in place
+         * without copying, use PopulationView.
+         *
+         * @param indices indices of the individuals (each at most once)
+         * @return population with the copied individuals in the order of indices
+         * @throws std::invalid_argument for out-of-range or repeated indices
+         */
+        Population copySubset(const std::vector<int>& indices) const {
+            checkSubsetIndices(indices);
+            std::vector<Network> selected;
+            selected.reserve(indices.size());
+            for(int i : indices){
+                selected.push_back(individuals[i]);
+            }
+            return Population(*this, std::move(selected), indices);
+        }
+
+        /**
+         * @brief Checks indices of a sub-population.
+         * @throws std::invalid_argument for out-of-range or repeated indices
+         */
+        void checkSubsetIndices(const std::vector<int>& indices) const {
+            std::vector<bool> seen(individuals.size(), false);
+            for(int i : indices){
+                if(i < 0 || static_cast<size_t>(i) >= individuals.size()){
+                    throw std::invalid_argument("subset index out of range");
+                }
+                if(seen[i]){
+                    throw std::invalid_argument("subset indices must be unique");
+                }
+                seen[i] = true;
+            }
+        }
+
+        /**
+         * @brief Serialises the state of the shared random generator.
+         *
+         * @details
+         * Together with the genomes this allows a run to be resumed with the same random
+         * stream (see saveCheckpoint()).
+         *
+         * @return textual state of the std::mt19937_64 generator
+         */
+        std::string generatorState() const {
+            std::ostringstream out;
+            out << *generator;
+            return out.str();
+        }
+
+        /**
+         * @brief Restores the state of the shared random generator.
+         *
+         * @details
+         * The generator object is shared with all individuals and nodes, so its state is
+         * overwritten in place.
+         *
+         * @param state textual state returned by generatorState()
+         * @throws std::invalid_argument if the state cannot be parsed
+         */
+        void setGeneratorState(const std::string& state){
+            std::istringstream in(state);
+            std::mt19937_64 restored;
+            if(!(in >> restored)){
+                throw std::invalid_argument("invalid random generator state");
+            }
+            *generator = restored;
+        }
+
         /**
          * @brief Initializes decision boundaries for all judgment nodes in all individuals.
          * 
@@ -159,7 +291,8 @@ class Population {
                            node.setEdgesBoundaries(minF[node.f], maxF[node.f]);
                        }
                    }
-               } 
+               }
+               network.genomeChanged();
             }
         }
 
@@ -185,15 +318,61 @@ class Population {
          * 
          * @param X Feature matrix where each inner vector represents one sample with multiple features
          * @param dMax Maximum consecutive judgment nodes allowed per decision (prevents infinite graph cycles)
+         * @param compact If true, the decisions are stored bit-packed in member compactDecisions
+         *  instead of member decisions (see Network::traversePathCompact())
          * 
          * @see Network::traversePath()
          */
         void callTraversePath(
                 const std::vector<std::vector<float>>& X,
-                int dMax
+                int dMax,
+                bool compact = false
                 ){
-            for (auto& network : individuals){
-                network.traversePath(X,dMax);
+            applyFitnessParallel([&](Network& network){
+                if(compact){
+                    network.traversePathCompact(X,dMax);
+                } else {
+                    network.traversePath(X,dMax);
+                }
+            });
+        }
+
+        /**
+         * @brief Writes the decisions of all individuals into one population-wide decision matrix.
+         *
+         * @details
+         * Row i of the (ni × X.size()) row-major matrix receives the decisions of individual i
+         * (see Network::traversePathInto(); -1 from the row on which an individual becomes
+         * invalid). The individuals are traversed in parallel (nThreads). Together with
+         * assignFitness() this allows a custom fitness to be computed for the whole
+         * population in one vectorised call.
+         *
+         * @tparam T Integer type of the matrix
+         * @param X Feature matrix where each inner vector represents one sample
+         * @param dMax Maximum consecutive judgment nodes allowed per decision
+         * @param out Row-major buffer with room for individuals.size() × X.size() decisions
+         */
+        template <typename T>
+        void decisionMatrix(
+                const std::vector<std::vector<float>>& X,
+                int dMax,
+                T* out
+                ){
+            parallelFor(individuals.size(), nThreads, [&](size_t i){
+                individuals[i].traversePathInto(X, dMax, out + i * X.size());
+            }, chunk);
+        }
+
+        /**
+         * @brief Sets the fitness of all individuals from a vector of values.
+         * @param values one fitness value per individual
+         */
+        void assignFitness(const std::vector<float>& values){
+            if(values.size() != individuals.size()){
+                throw std::invalid_argument("one fitness value per individual is required");
+            }
+            for(size_t i=0; i<individuals.size(); i++){
+                individuals[i].fitness = values[i];
             }
         }
 
@@ -216,6 +395,27 @@ class Population {
             }
         }
 
+        /**
+         * @brief Applies a generic fitness function to all individuals in parallel.
+         *
+         * @details
+         * Same as applyFitness(), but the individuals are distributed over nThreads
+         * threads (see parallelFor()). Used by the data-based fitness functions, which
+         * only touch the state of the evaluated network.
+         *
+         * @tparam FuncFitness Callable type that accepts Network& and evaluates fitness
+         * @param func Fitness function to apply (must accept Network& parameter)
+         *
+         * @warning func must not use the shared random generator or other shared mutable
+         * state (e.g. cartpole() draws initial states from the generator and stays serial)
+         */
+        template <typename FuncFitness>
+        void applyFitnessParallel(FuncFitness&& func){
+            parallelFor(individuals.size(), nThreads, [&](size_t i){
+                func(individuals[i]);
+            }, chunk);
+        }
+
         /** @cond INTERNAL */
 
         /**
@@ -254,10 +454,315 @@ class Population {
                 int dMax,
                 int penalty
                 ){
-            applyFitness([=](Network& network){
+            applyFitnessParallel([&](Network& network){
                     network.fitAccuracy(X,y,dMax,penalty);
             });
         }
+
+        /**
+         * @brief Evaluates all individuals using classification accuracy on a Data object with derived features.
+         *
+         * @details
+         * Like accuracy() for a feature matrix, but judgment nodes can read the virtual
+         * feature columns declared on data (see Data::addLagFeature() and friends).
+         * To use them, the population must be created with jnf = data.nFeatures() and the
+         * boundaries must be set with the min/max values of all features
+         * (Data::minMaxFeatures() followed by Data::minMaxDerivedFeatures()).
+         *
+         * @param data Data object with member X and derived features
+         * @param y Target labels vector corresponding to each row of data.X
+         * @param dMax Maximum consecutive judgment nodes per decision (prevents infinite loops)
+         * @param penalty Divisor for fitness reduction on constraint violations (currently unused)
+         *
+         * @see Network::fitAccuracy()
+         */
+        void accuracy(
+                const Data& data,
+                const std::vector<int>& y,
+                int dMax,
+                int penalty
+                ){
+            applyFitnessParallel([&](Network& network){
+                    network.fitAccuracy(data,y,dMax,penalty);
+            });
+        }
+
+        /**
+         * @brief Evaluates all individuals incrementally on a sliding window of streaming data.
+         *
+         * @details
+         * Applies Network::fitStreamingAccuracy() to each individual. Individuals whose
+         * genome has not changed since the last call (e.g. elite) only evaluate the rows
+         * appended to the window since then, so the cost per update is proportional to
+         * the new data. Individuals modified by genetic operators are evaluated on the
+         * whole window.
+         *
+         * @param window sliding window with the current rows and labels
+         * @param dMax Maximum consecutive judgment nodes per decision (prevents infinite loops)
+         * @param reanchorInterval Number of incrementally evaluated rows after which an individual is evaluated from scratch
+         *
+         * @see Network::fitStreamingAccuracy()
+         */
+        void streamingAccuracy(
+                const StreamWindow& window,
+                int dMax,
+                size_t reanchorInterval
+                ){
+            applyFitnessParallel([&](Network& network){
+                    network.fitStreamingAccuracy(window, dMax, reanchorInterval);
+            });
+        }
+
+        /**
+         * @brief Evaluates all individuals as trading rules with a native backtest.
+         *
+         * @details
+         * Applies Network::fitBacktest() to each individual in parallel. The decisions are
+         * consumed while the networks traverse X, so no decisions are stored or exported.
+         *
+         * @param X Feature matrix (rows are time steps, columns are features)
+         * @param returns Asset return per row of X (held with the position decided at that row)
+         * @param positions Position per processing node function (empty = decision is the position)
+         * @param dMax Maximum consecutive judgment nodes per decision (prevents infinite loops)
+         * @param worstFitness Fitness value assigned to invalid networks
+         * @param cost Transaction cost per unit of turnover
+         * @param metric Fitness metric: "return", "sharpe" or "calmar"
+         * @param periodsPerYear Rows per year used to annualise the Sharpe ratio
+         *
+         * @see Network::fitBacktest(), BacktestAccumulator
+         */
+        void backtest(
+                const std::vector<std::vector<float>>& X,
+                const std::vector<float>& returns,
+                const std::vector<float>& positions,
+                int dMax,
+                float worstFitness,
+                float cost = 0,
+                const std::string& metric = "sharpe",
+                float periodsPerYear = 252
+                ){
+            if(returns.size() > X.size()){
+                throw std::invalid_argument("returns has more rows than X");
+            }
+            if(!positions.empty() && positions.size() < pnf){
+                throw std::invalid_argument("positions must contain one position per processing node function (pnf)");
+            }
+            BacktestAccumulator::checkMetric(metric);
+            applyFitnessParallel([&](Network& network){
+                    network.fitBacktest(X, returns, positions, dMax, worstFitness, cost, metric, periodsPerYear);
+            });
+        }
+
+        /**
+         * @brief Evaluates all individuals on several independent series with classification accuracy.
+         *
+         * @details
+         * All series are stored back to back in one buffer X; series s occupies the rows
+         * [offsets[s], offsets[s+1]). Each network restarts its traversal at every series
+         * boundary. Individuals are evaluated in parallel (nThreads); the series of one
+         * individual run back to back on the same thread so that the used flags stay exact.
+         * The per-series scores are stored in fitnessValues and aggregated into fitness
+         * (mean, worst or quantile) and objectives ({mean, worst}).
+         *
+         * @param X Feature matrix of all series
+         * @param y Target labels per row of X
+         * @param offsets Series boundaries (number of series + 1 values)
+         * @param dMax Maximum consecutive judgment nodes per decision
+         * @param aggregation "mean", "worst" or "quantile"
+         * @param q Quantile used by "quantile"
+         *
+         * @see Network::fitAccuracyMultiSeries()
+         */
+        void multiSeriesAccuracy(
+                const std::vector<std::vector<float>>& X,
+                const std::vector<int>& y,
+                const std::vector<size_t>& offsets,
+                int dMax,
+                const std::string& aggregation = "mean",
+                float q = 0.5
+                ){
+            checkSeriesOffsets(offsets, X.size());
+            checkAggregation(aggregation, q);
+            if(y.size() != X.size()){
+                throw std::invalid_argument("y must have one label per row of X");
+            }
+            applyFitnessParallel([&](Network& network){
+                    network.fitAccuracyMultiSeries(X, y, offsets, dMax, aggregation, q);
+            });
+        }
+
+        /**
+         * @brief Evaluates all individuals as trading rules on several independent series (instruments).
+         *
+         * @details
+         * Same layout and parallelisation as multiSeriesAccuracy(); every series is backtested
+         * separately starting flat (see Network::fitBacktestMultiSeries()).
+         *
+         * @param X Feature matrix of all series
+         * @param returns Asset return per row of X
+         * @param offsets Series boundaries (number of series + 1 values)
+         * @param positions Position per processing node function (empty = decision is the position)
+         * @param dMax Maximum consecutive judgment nodes per decision
+         * @param worstFitness Score of a series on which a network becomes invalid
+         * @param cost Transaction cost per unit of turnover
+         * @param metric Per-series metric: "return", "sharpe" or "calmar"
+         * @param periodsPerYear Rows per year used to annualise the Sharpe ratio
+         * @param aggregation "mean", "worst" or "quantile"
+         * @param q Quantile used by "quantile"
+         */
+        void multiSeriesBacktest(
+                const std::vector<std::vector<float>>& X,
+                const std::vector<float>& returns,
+                const std::vector<size_t>& offsets,
+                const std::vector<float>& positions,
+                int dMax,
+                float worstFitness,
+                float cost = 0,
+                const std::string& metric = "sharpe",
+                float periodsPerYear = 252,
+                const std::string& aggregation = "mean",
+                float q = 0.5
+                ){
+            checkSeriesOffsets(offsets, X.size());
+            checkAggregation(aggregation, q);
+            BacktestAccumulator::checkMetric(metric);
+            if(returns.size() != X.size()){
+                throw std::invalid_argument("returns must have one value per row of X");
+            }
+            if(!positions.empty() && positions.size() < pnf){
+                throw std::invalid_argument("positions must contain one position per processing node function (pnf)");
+            }
+            applyFitnessParallel([&](Network& network){
+                    network.fitBacktestMultiSeries(X, returns, offsets, positions, dMax, worstFitness,
+                                                   cost, metric, periodsPerYear, aggregation, q);
+            });
+        }
+
+        /**
+         * @brief Cross-validates all individuals with classification accuracy.
+         *
+         * @details
+         * All folds of all individuals are evaluated in one parallel pass (nThreads) over
+         * the shared data set; folds only hold row indices, so no rows are copied. The
+         * per-fold scores are stored in fitnessValues and aggregated into fitness.
+         *
+         * @param X Feature matrix of the whole data set
+         * @param y Target labels per row of X
+         * @param folds Fold index sets (see kFoldSplits(), walkForwardSplits())
+         * @param dMax Maximum consecutive judgment nodes per decision
+         * @param part Evaluated part of every fold: "train" or "test"
+         * @param aggregation "mean", "worst" or "quantile"
+         * @param q Quantile used by "quantile"
+         *
+         * @see Network::fitAccuracyFolds()
+         */
+        void crossValidationAccuracy(
+                const std::vector<std::vector<float>>& X,
+                const std::vector<int>& y,
+                const std::vector<Fold>& folds,
+                int dMax,
+                const std::string& part = "test",
+                const std::string& aggregation = "mean",
+                float q = 0.5
+                ){
+            checkFolds(folds, X.size());
+            checkAggregation(aggregation, q);
+            if(part != "train" && part != "test"){
+                throw std::invalid_argument("unknown fold part: " + part + " (use train or test)");
+            }
+            if(y.size() != X.size()){
+                throw std::invalid_argument("y must have one label per row of X");
+            }
+            applyFitnessParallel([&](Network& network){
+                    network.fitAccuracyFolds(X, y, folds, dMax, part, aggregation, q);
+            });
+        }
+
+        /**
+         * @brief Evaluates all individuals with a registered native fitness kernel.
+         *
+         * @details
+         * The kernel is looked up by name in the FitnessRegistry (compiled-in kernels or
+         * plugins loaded with loadFitnessPlugin()) and runs on the parallel evaluation
+         * engine (nThreads) like the built-in fitness functions.
+         *
+         * @param name Name of the kernel
+         * @param X Feature matrix where each inner vector represents one sample
+         * @param targets Row-major target matrix with X.size() rows (labels, returns, ...)
+         * @param nCols Number of columns of targets (0 if the kernel needs no targets)
+         * @param dMax Maximum consecutive judgment nodes per decision
+         * @param worstFitness Fitness of invalid networks
+         *
+         * @see Network::fitNative()
+         */
+        void nativeFitness(
+                const std::string& name,
+                const std::vector<std::vector<float>>& X,
+                const std::vector<float>& targets,
+                size_t nCols,
+                int dMax,
+                float worstFitness
+                ){
+            std::shared_ptr<const FracneticsFitnessKernel> kernel = FitnessRegistry::instance().find(name);
+            if(targets.size() != X.size() * nCols){
+                throw std::invalid_argument("targets must have nCols values per row of X");
+            }
+            const float* data = targets.empty() ? nullptr : targets.data();
+            applyFitnessParallel([&](Network& network){
+                    network.fitNative(X, *kernel, data, nCols, dMax, worstFitness);
+            });
+        }
+
+        /**
+         * @brief Evaluates all individuals with a classification metric.
+         *
+         * @details
+         * Balanced accuracy, macro F1 and Cohen's kappa are computed from confusion counts
+         * that are accumulated during the traversal (see Network::fitClassification()).
+         * The individuals are evaluated in parallel (nThreads). Optionally the confusion
+         * matrices of all individuals are written into one contiguous buffer, which allows
+         * further population-wide reductions in a single vectorised step.
+         *
+         * @param X Feature matrix where each inner vector represents one sample
+         * @param y Target labels (0 .. nClasses-1, nClasses = max(y) + 1)
+         * @param dMax Maximum consecutive judgment nodes per decision
+         * @param metric "accuracy", "balancedAccuracy", "macroF1" or "kappa"
+         * @param confusion Optional output: row-major (ni × nClasses × nClasses) counts,
+         *  rows of a matrix are true classes
+         * @return number of classes
+         */
+        size_t classificationMetric(
+                const std::vector<std::vector<float>>& X,
+                const std::vector<int>& y,
+                int dMax,
+                const std::string& metric,
+                std::vector<uint32_t>* confusion = nullptr
+                ){
+            ConfusionAccumulator::checkMetric(metric);
+            if(y.size() != X.size()){
+                throw std::invalid_argument("y must have one label per row of X");
+            }
+            int maxLabel = -1;
+            for(int label : y){
+                if(label < 0){
+                    throw std::invalid_argument("class labels must be >= 0");
+                }
+                maxLabel = std::max(maxLabel, label);
+            }
+            size_t nClasses = maxLabel + 1;
+            size_t cells = nClasses * nClasses;
+            if(confusion != nullptr){
+                confusion->assign(individuals.size() * cells, 0);
+            }
+            parallelFor(individuals.size(), nThreads, [&](size_t i){
+                ConfusionAccumulator counts(nClasses);
+                individuals[i].fitClassification(X, y, nClasses, dMax, metric, &counts);
+                if(confusion != nullptr){
+                    std::copy(counts.matrix().begin(), counts.matrix().end(), confusion->begin() + i * cells);
+                }
+            }, chunk);
+            return nClasses;
+        }
         /** @endcond */
 
         /**
@@ -267,22 +772,26 @@ class Population {
          * This method applies fitGymnasium() to the entire population as reinforcement learning agents in
          * a Gymnasium environment. 
          * 
-         * @param env GymEnvWrapper object providing interface to the Gymnasium environment
+         * @param env Environment (see Environment.hpp), e.g. GymEnvWrapper for Python Gymnasium environments
          * @param dMax Maximum consecutive judgment nodes per decision (prevents infinite loops in graph traversal)
          * @param maxSteps Maximum episode length (prevents indefinite episodes)
          * @param maxConsecutiveP Maximum consecutive processing nodes allowed 
          * @param worstFitness Fitness value assigned when networks violate constraints
          * @param seed Random seed for environment initialization (currently unused in implementation)
+         * @param bound Early termination bound (inactive by default): episodes that can no longer
+         * reach bound.threshold are cut short and the networks are marked as truncated
          * 
-         * @see Network::fitGymnasium()
+         * @see Network::fitGymnasium(), EpisodeBound
          */
+        template <Environment Env>
         void gymnasium(
-            GymEnvWrapper& env,
+            Env& env,
             int dMax,
             int maxSteps,
             int maxConsecutiveP,
             int worstFitness,
-            int seed
+            int seed,
+            const EpisodeBound& bound = {}
                 ){
 
             for(auto& network : individuals){
@@ -292,7 +801,9 @@ class Population {
                         maxSteps,
                         maxConsecutiveP,
                         worstFitness,
-                        seed
+                        seed,
+                        true,
+                        bound
                         );
             }
         }
@@ -365,6 +876,7 @@ class Population {
             minFitness = individuals[0].fitness;
             bestFit = individuals[0].fitness;
             maxNetworkSize = individuals[0].innerNodes.size();
+            bool parsimony = budget.active(); // prefer smaller individuals at equal fitness
 
             for(int i=0; i<individuals.size()-E; i++){
                 if(individuals[i].innerNodes.size() > maxNetworkSize){
@@ -379,7 +891,9 @@ class Population {
                     tournament.insert(randomInt);
                 }
                 for(int k : tournament){
-                   if(individuals[k].fitness > bestFitTournament){
+                   if(individuals[k].fitness > bestFitTournament ||
+                      (parsimony && individuals[k].fitness == bestFitTournament &&
+                       individuals[k].innerNodes.size() < individuals[indexBestIndTournament].innerNodes.size())){
                        bestFitTournament = individuals[k].fitness;
                        indexBestIndTournament = k;
                    } 
@@ -424,7 +938,9 @@ class Population {
                 unsigned int bestCandIdx = 0;
                 for(unsigned int c = 0; c < candidateIndices.size(); ++c){
                     unsigned int idx = candidateIndices[c];
-                    if(individuals[idx].fitness > eliteFit){
+                    if(individuals[idx].fitness > eliteFit ||
+                       (budget.active() && individuals[idx].fitness == eliteFit &&
+                        individuals[idx].innerNodes.size() < individuals[candidateIndices[bestCandIdx]].innerNodes.size())){
                         eliteFit = individuals[idx].fitness;
                         bestCandIdx = c;
                     }
@@ -489,6 +1005,7 @@ class Population {
                         }
                     }
                     individuals[i].startNode.edgeMutation(probStartNode, individuals[i].innerNodes.size(), k, N);
+                    individuals[i].genomeChanged();
                  }
              }
         }
@@ -524,6 +1041,7 @@ class Population {
                 if (std::find(indicesElite.begin(), indicesElite.end(), i) == indicesElite.end()) {
                     additionalMutationParam amp;
                     amp.networkSize = individuals[i].innerNodes.size();
+                    individuals[i].genomeChanged();
                     for (auto& node : individuals[i].innerNodes) {
                         if (node.type == "J") {
                            if (justUsedNodes == true) {
@@ -747,6 +1265,8 @@ class Population {
 
                 auto& parent1 = individuals[inds[i]];
                 auto& parent2 = individuals[inds[i+1]];
+                if(!parent1IsElite){ parent1.genomeChanged(); }
+                if(!parent2IsElite){ parent2.genomeChanged(); }
 
                 // check parent sizes 
                 bool parent1IsLarger;
@@ -943,6 +1463,7 @@ class Population {
                     }
                 }
             }
+            enforceBudget(false); // randomWidth may grow networks; the used flags are outdated here
         }
 
         /**
@@ -1165,13 +1686,118 @@ class Population {
          * @see Network::addDelNodes()
          */
         void callAddDelNodes(std::vector<float>& minF, std::vector<float>& maxF, float junk=0, bool noElite = false){
+            MemoryUsage usage;
+            if(budget.active()){
+                usage = memoryUsage();
+            }
 
             for(int i=0; i<individuals.size(); i++){
 
                 if (std::find(indicesElite.begin(), indicesElite.end(), i) == indicesElite.end()) {continue;} // skip elite individuals if noElite is true
-                individuals[i].addDelNodes(minF, maxF, junk, nFeatureValues);
+                bool allowGrowth = true;
+                if(budget.active()){
+                    allowGrowth = budget.allowsGrowth(usage);
+                    budgetStats.rejectedGrowth += !allowGrowth;
+                    usage.nodes -= individuals[i].innerNodes.size();
+                    usage.bytes -= individuals[i].genomeBytes();
+                }
+                individuals[i].addDelNodes(minF, maxF, junk, nFeatureValues, allowGrowth);
+                individuals[i].genomeChanged();
+                if(budget.active()){
+                    usage.nodes += individuals[i].innerNodes.size();
+                    usage.bytes += individuals[i].genomeBytes();
+                }
 
             }
+            enforceBudget(true);
+        }
+
+        /**
+         * @brief Total genome size of the population.
+         *
+         * @details
+         * Uses the cached Network::genomeBytes(), so only individuals modified since the
+         * last call are measured again.
+         */
+        MemoryUsage memoryUsage(){
+            MemoryUsage usage;
+            for(Network& network : individuals){
+                usage.nodes += network.innerNodes.size();
+                usage.bytes += network.genomeBytes();
+                usage.largestNetwork = std::max(usage.largestNetwork, network.innerNodes.size());
+            }
+            return usage;
+        }
+
+        /**
+         * @brief Shrinks the population into its GenomeBudget.
+         *
+         * @details
+         * Does nothing if the budget is inactive or not exceeded. Otherwise non-elite
+         * individuals are trimmed, largest first:
+         * 1. nodes that are unreachable from the start node are removed (never traversed,
+         *    see Network::pruneUnreachable())
+         * 2. if pruneUnused is true and the budget is still exceeded, nodes that were not
+         *    used in the last traversal are deleted (see Network::pruneUnused()); this
+         *    requires up-to-date used flags, i.e. a traversal since the last edge change
+         *
+         * Called by callAddDelNodes() (with pruneUnused) and crossover() (without).
+         * Growth is additionally rejected by callAddDelNodes() while the budget is
+         * exhausted, and selection prefers smaller individuals at equal fitness.
+         *
+         * @param pruneUnused also delete reachable nodes that were not used
+         * @return number of removed nodes
+         */
+        size_t enforceBudget(bool pruneUnused = true){
+            if(!budget.active()){
+                return 0;
+            }
+            MemoryUsage usage = memoryUsage();
+            if(!budget.exceeded(usage)){
+                return 0;
+            }
+            std::vector<int> order;
+            for(size_t i=0; i<individuals.size(); i++){
+                if(std::find(indicesElite.begin(), indicesElite.end(), static_cast<int>(i)) == indicesElite.end()){
+                    order.push_back(static_cast<int>(i));
+                }
+            }
+            std::stable_sort(order.begin(), order.end(), [&](int a, int b){
+                return individuals[a].innerNodes.size() > individuals[b].innerNodes.size();
+            });
+            size_t removed = 0;
+            auto trim = [&](auto&& prune, size_t& counter){
+                for(int i : order){
+                    if(!budget.exceeded(usage)){
+                        break;
+                    }
+                    Network& network = individuals[i];
+                    size_t nodes = network.innerNodes.size();
+                    size_t bytes = network.genomeBytes();
+                    size_t n = prune(network, usage);
+                    usage.nodes = usage.nodes - nodes + network.innerNodes.size();
+                    usage.bytes = usage.bytes - bytes + network.genomeBytes();
+                    counter += n;
+                    removed += n;
+                }
+            };
+            trim([](Network& network, const MemoryUsage&){ return network.pruneUnreachable(); },
+                 budgetStats.prunedUnreachable);
+            if(pruneUnused){
+                trim([&](Network& network, const MemoryUsage& current){
+                        size_t excess = 0;
+                        if(budget.maxNodes > 0 && current.nodes > budget.maxNodes){
+                            excess = current.nodes - budget.maxNodes;
+                        }
+                        if(budget.maxBytes > 0 && current.bytes > budget.maxBytes){
+                            size_t nodeBytes = std::max<size_t>(1, current.bytes / std::max<size_t>(1, current.nodes));
+                            excess = std::max(excess, (current.bytes - budget.maxBytes + nodeBytes - 1) / nodeBytes);
+                        }
+                        return network.pruneUnused(excess);
+                     },
+                     budgetStats.prunedUnused);
+            }
+            return removed;
         }
 
         /**
@@ -1182,20 +1808,30 @@ class Population {
          * are stored in network.fitnessValues. The aggregated fitness is stored in
          * network.fitness as the mean reward across all seeds.
          *
-         * @param env GymEnvWrapper object providing interface to the Gymnasium environment
+         * @param env Environment (see Environment.hpp), e.g. GymEnvWrapper for Python Gymnasium environments
          * @param dMax Maximum consecutive judgment nodes per decision
          * @param maxSteps Maximum episode length
          * @param maxConsecutiveP Maximum consecutive processing nodes allowed
          * @param worstFitness Fitness value assigned when networks violate constraints
          * @param seeds Vector of random seeds for environment initialization
+         * @param bound Early termination bound on the mean reward (inactive by default). An episode
+         * is cut short as soon as the mean over all seeds cannot reach bound.threshold, even with
+         * maxStepReward on every remaining step of this and the following seeds; the remaining
+         * seeds are skipped and the network is marked as truncated. fitnessValues and
+         * lastStepRewards then only hold the seeds that ran (the cut seed with its best reachable
+         * return, see EpisodeBound::best()). The fitness is aggregated like a full run: the mean
+         * over all seeds, with maxStepReward on every step of the skipped seeds. It stays below
+         * bound.threshold.
          */
+        template <Environment Env>
         void gymnasiumMultiSeed(
-            GymEnvWrapper& env,
+            Env& env,
             int dMax,
             int maxSteps,
             int maxConsecutiveP,
             int worstFitness,
-            const std::vector<int>& seeds
+            const std::vector<int>& seeds,
+            const EpisodeBound& bound = {}
                 ){
 
             for(auto& network : individuals){
@@ -1204,18 +1840,24 @@ class Population {
                 float totalReward = 0.0f;
                 bool firstSeed = true;
 
-                for(int s : seeds){
-
-                    if(firstSeed == true){
-                        network.fitGymnasium(env, dMax, maxSteps, maxConsecutiveP, worstFitness, s, true);
-                    } else {
-                        network.fitGymnasium(env, dMax, maxSteps, maxConsecutiveP, worstFitness, s, false);
+                for(size_t i=0; i<seeds.size(); i++){
+                    // threshold of this episode: the total still needed minus the best case of the following seeds
+                    EpisodeBound episodeBound = bound;
+                    if(bound.active()){
+                        episodeBound.threshold = bound.threshold * seeds.size() - totalReward -
+                            bound.maxStepReward * maxSteps * (seeds.size() - i - 1);
                     }
+                    network.fitGymnasium(env, dMax, maxSteps, maxConsecutiveP, worstFitness, seeds[i], firstSeed, episodeBound);
 
                     network.fitnessValues.push_back(network.fitness);
                     network.lastStepRewards.push_back(network.lastFitness);
                     totalReward += network.fitness;
                     firstSeed = false;
+                    if(network.truncated){
+                        // skipped seeds count with their best reachable return
+                        totalReward += bound.best(0, maxSteps) * (seeds.size() - i - 1);
+                        break;
+                    }
                 }
 
                 // Default aggregation: mean reward
@@ -1223,6 +1865,80 @@ class Population {
             }
         }
 
+        /**
+         * @brief Sets the capacity of the return history of all individuals.
+         *
+         * @details
+         * Existing histories keep their newest returns. Individuals created later by
+         * selection are copies and therefore share the capacity.
+         *
+         * @param capacity number of returns kept per individual
+         */
+        void setSeedHistoryCapacity(size_t capacity){
+            for(auto& network : individuals){
+                network.seedHistory.setCapacity(capacity);
+            }
+        }
+
+        /**
+         * @brief Replaces the n oldest rolling seeds of seedPool by new random seeds.
+         * @param n number of seeds to replace
+         * @return seeds of the pool (anchors followed by rolling seeds)
+         */
+        std::vector<int> rollSeedPool(size_t n = 1){
+            seedPool.roll(*generator, n);
+            return seedPool.seeds();
+        }
+
+        /**
+         * @brief Evaluates all individuals on several seeds and aggregates their return history.
+         *
+         * @details
+         * Runs gymnasiumMultiSeed() and appends the per-seed returns of each individual to its
+         * seedHistory (a ring buffer, see setSeedHistoryCapacity()). The fitness is the
+         * aggregate of the whole history, so it smooths the returns over generations. The
+         * history is copied with the individuals in selection; parents pass it on to their
+         * offspring.
+         *
+         * @param env Environment (see Environment.hpp), e.g. GymEnvWrapper for Python Gymnasium environments
+         * @param dMax Maximum consecutive judgment nodes per decision
+         * @param maxSteps Maximum episode length
+         * @param maxConsecutiveP Maximum consecutive processing nodes allowed
+         * @param worstFitness Fitness value assigned when networks violate constraints
+         * @param seeds Seeds of this generation, e.g. seedPool.seeds()
+         * @param aggregation "mean", "ema", "worstk" or "quantile" (see SeedHistory)
+         * @param param alpha (ema), k (worstk) or q (quantile)
+         * @param bound Early termination bound on the mean of this generation's seeds (see gymnasiumMultiSeed())
+         *
+         * @throws std::invalid_argument if the aggregation is unknown or the history capacity is 0
+         */
+        template <Environment Env>
+        void gymnasiumSeedHistory(
+            Env& env,
+            int dMax,
+            int maxSteps,
+            int maxConsecutiveP,
+            int worstFitness,
+            const std::vector<int>& seeds,
+            const std::string& aggregation = "mean",
+            float param = 0.5,
+            const EpisodeBound& bound = {}
+                ){
+            checkSeedAggregation(aggregation, param);
+            for(const auto& network : individuals){
+                if(network.seedHistory.capacity() == 0){
+                    throw std::invalid_argument("set the seed history capacity first (setSeedHistoryCapacity)");
+                }
+            }
+            gymnasiumMultiSeed(env, dMax, maxSteps, maxConsecutiveP, worstFitness, seeds, bound);
+            for(auto& network : individuals){
+                for(float value : network.fitnessValues){
+                    network.seedHistory.push(value);
+                }
+                network.fitness = network.seedHistory.aggregate(aggregation, param);
+            }
+        }
+
         /**
          * @brief Calculates Pareto objectives (landing rate, mean reward) from fitnessValues.
          * 
@@ -1423,6 +2139,108 @@ class Population {
             }
         }
 
+        /**
+         * @brief Estimates the structural diversity of the population from MinHash sketches.
+         *
+         * @details
+         * Sketches of individuals whose genome changed since the last report are rebuilt in
+         * parallel (nThreads, see Network::minHash()); all other sketches are reused. The
+         * statistics (mean pairwise similarity, LSH clusters, duplicate ratio) are computed
+         * in O(ni·K) by sketchDiversity(). A collapsing population shows up as rising
+         * meanSimilarity and duplicateRatio and a falling number of clusters, e.g. to
+         * trigger a restart or migration.
+         *
+         * @param K number of bins per sketch
+         * @param nBands number of LSH bands for the clusters (must divide K)
+         * @return diversity statistics
+         */
+        DiversityStats diversity(size_t K = 64, size_t nBands = 16){
+            if(K == 0 || nBands == 0 || K % nBands != 0){
+                throw std::invalid_argument("diversity needs K >= 1 and nBands dividing K");
+            }
+            std::vector<char> rebuilt(individuals.size(), 0);
+            parallelFor(individuals.size(), nThreads, [&](size_t i){
+                Network& network = individuals[i];
+                rebuilt[i] = network.sketch.dirty || network.sketch.values.size() != K;
+                network.minHash(K);
+            }, chunk);
+            std::vector<const MinHashSketch*> sketches;
+            sketches.reserve(individuals.size());
+            for(const Network& network : individuals){
+                sketches.push_back(&network.sketch);
+            }
+            DiversityStats stats = sketchDiversity(sketches, nBands);
+            stats.recomputed = std::count(rebuilt.begin(), rebuilt.end(), 1);
+            return stats;
+        }
+
+        /**
+         * @brief Appends a novelty objective to the objectives of all individuals.
+         *
+         * @details
+         * The behaviour descriptor of every individual is hashed to a SimHash signature
+         * and its novelty is queried against the archive (approximate k-NN, see
+         * BehaviorArchive). The objectives become {fitness, novelty}, or the novelty is
+         * appended to the current objectives (extend = true, e.g. right after
+         * calculateParetoObjectives(), which sets them anew each generation), so
+         * paretoTournamentSelection() trades novelty off against the other objectives.
+         * Afterwards the nArchive most novel individuals are added to the archive.
+         * Signatures and queries run in parallel (nThreads).
+         *
+         * Call it after the fitness evaluation and before the selection.
+         *
+         * @param archive behaviour archive (updated)
+         * @param descriptor "decisions" (Network::decisions, e.g. after callTraversePath())
+         *  or "behavior" (Network::behavior quantised with quantum, e.g. the final
+         *  observation of gymnasium())
+         * @param quantum bucket width of the "behavior" descriptor
+         * @param nArchive number of individuals added to the archive
+         * @param extend if true, the novelty is appended to the objectives of this
+         *  generation instead of replacing them by {fitness, novelty}
+         * @return novelty of each individual
+         */
+        std::vector<float> noveltyObjective(
+                BehaviorArchive& archive,
+                const std::string& descriptor = "decisions",
+                float quantum = 1,
+                size_t nArchive = 1,
+                bool extend = false
+                ){
+            if(descriptor != "decisions" && descriptor != "behavior"){
+                throw std::invalid_argument("unknown novelty descriptor: " + descriptor + " (use decisions or behavior)");
+            }
+            if(descriptor == "behavior" && !(quantum > 0)){
+                throw std::invalid_argument("quantum must be > 0");
+            }
+            std::vector<BehaviorArchive::Signature> signatures(individuals.size());
+            std::vector<float> novelty(individuals.size());
+            parallelFor(individuals.size(), nThreads, [&](size_t i){
+                const Network& network = individuals[i];
+                signatures[i] = archive.signature(descriptor == "decisions"
+                    ? network.decisions
+                    : BehaviorArchive::quantise(network.behavior, quantum));
+                novelty[i] = archive.novelty(signatures[i]);
+            }, chunk);
+            for(size_t i=0; i<individuals.size(); i++){
+                Network& network = individuals[i];
+                if(extend){
+                    network.objectives.push_back(novelty[i]);
+                } else {
+                    network.objectives = {network.fitness, novelty[i]};
+                }
+            }
+            std::vector<size_t> order(individuals.size());
+            std::iota(order.begin(), order.end(), 0);
+            nArchive = std::min(nArchive, order.size());
+            std::partial_sort(order.begin(), order.begin() + nArchive, order.end(), [&](size_t a, size_t b){
+                return novelty[a] > novelty[b] || (novelty[a] == novelty[b] && a < b);
+            });
+            for(size_t i=0; i<nArchive; i++){
+                archive.add(signatures[order[i]]);
+            }
+            return novelty;
+        }
+
 };
 
 #endif
@@ -0,0 +1,119 @@
+#ifndef POPULATIONVIEW_HPP
+#define POPULATIONVIEW_HPP
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include "Population.hpp"
+
+/**
+ * @class PopulationView
+ * @brief Sub-population over selected individuals of a population, without copies.
+ *
+ * @details
+ * The selected networks are moved into a Population of their own (O(E) pointer moves,
+ * no genome copies), so every population method (evaluation, gymnasium(),
+ * callTraversePath(), ...) works on the view. release() moves the networks back into
+ * their original slots, including all changes made through the view (fitness,
+ * decisions, mutations). The destructor releases automatically.
+ *
+ * While the view is active, the parent is marked as borrowed and must not be used;
+ * the Python bindings reject calls on it until the view is released.
+ *
+ * @code
+ * {
+ *     PopulationView elite(population, population.indicesElite);
+ *     elite.population().gymnasium(env, dMax, maxSteps, maxConsecutiveP, worstFitness, seed);
+ * } // fitness values are now stored in population.individuals
+ * @endcode
+ */
+class PopulationView {
+    public:
+        /**
+         * @param _parent population to take the individuals from (must outlive the view)
+         * @param _indices indices of the individuals (each at most once)
+         * @throws std::invalid_argument for out-of-range or repeated indices
+         * @throws std::runtime_error if the parent is borrowed or being evaluated
+         */
+        PopulationView(Population& _parent, std::vector<int> _indices):
+            parent(&_parent),
+            indices(std::move(_indices))
+        {
+            std::lock_guard<std::mutex> lock(parent->mutex.get());
+            if(parent->borrowed || parent->evaluating){
+                throw std::runtime_error("population is already borrowed by a view or being evaluated");
+            }
+            parentSize = parent->individuals.size();
+            parent->checkSubsetIndices(indices);
+            std::vector<Network> selected;
+            selected.reserve(indices.size());
+            for(int i : indices){
+                selected.push_back(std::move(parent->individuals[i]));
+            }
+            sub = std::make_unique<Population>(*parent, std::move(selected), indices);
+            parent->borrowed = true;
+        }
+
+        PopulationView(const PopulationView&) = delete;
+        PopulationView& operator=(const PopulationView&) = delete;
+
+        ~PopulationView(){
+            try {
+                release();
+            } catch(const std::runtime_error&){
+                // the parent changed size: the individuals of the view are dropped
+            }
+        }
+
+        /**
+         * @brief The sub-population.
+         * @throws std::runtime_error after release()
+         */
+        Population& population(){
+            if(!active()){
+                throw std::runtime_error("population view was released");
+            }
+            return *sub;
+        }
+
+        const std::vector<int>& parentIndices() const { return indices; } /**< index of each individual in the parent */
+        bool active() const { return !released; } /**< false after release() */
+
+        /**
+         * @brief Moves the individuals back into the parent and unblocks it.
+         *
+         * @details
+         * Individual i of the view returns to slot parentIndices()[i]. Calling release()
+         * again is a no-op. The sub-population is empty afterwards.
+         *
+         * @throws std::runtime_error if the number of individuals of the parent changed while
+         * the view was active (the slots no longer exist); the parent is unblocked and the
+         * individuals of the view are discarded
+         */
+        void release(){
+            if(released){
+                return;
+            }
+            released = true;
+            std::lock_guard<std::mutex> lock(parent->mutex.get());
+            parent->borrowed = false;
+            if(parent->individuals.size() != parentSize){
+                sub->individuals.clear();
+                throw std::runtime_error("population changed its size while a view was active");
+            }
+            // selection on the view keeps the size, so every slot gets an individual back
+            for(size_t i=0; i<indices.size() && i<sub->individuals.size(); i++){
+                parent->individuals[indices[i]] = std::move(sub->individuals[i]);
+            }
+            sub->individuals.clear();
+        }
+
+    private:
+        Population* parent;
+        std::vector<int> indices;
+        size_t parentSize; // number of individuals of the parent when the view was created
+        std::unique_ptr<Population> sub;
+        bool released = false;
+};
+
+#endif
@@ -0,0 +1,190 @@
+#ifndef SEEDHISTORY_HPP
+#define SEEDHISTORY_HPP
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Aggregation.hpp"
+
+/**
+ * @file SeedHistory.hpp
+ * @brief Per-individual history of episode returns and the pool of evaluation seeds.
+ *
+ * @details
+ * Episodic fitness (e.g. LunarLander) is noisy: a network that lands on one seed can
+ * crash on the next. Individuals therefore keep the returns of their last episodes in a
+ * fixed-capacity ring buffer (SeedHistory), and the fitness is an aggregate of the whole
+ * history. The history is a member of Network, so it is copied with the individual in
+ * tournament selection and survives across generations.
+ *
+ * @see Population::gymnasiumSeedHistory()
+ */
+
+/**
+ * @brief Checks a seed history aggregation before an evaluation starts.
+ * @param aggregation "mean", "ema", "worstk" or "quantile"
+ * @param param alpha in (0, 1] (ema), k >= 1 (worstk) or q in [0, 1] (quantile)
+ */
+inline void checkSeedAggregation(const std::string& aggregation, float param){
+    if(aggregation == "mean"){
+        return;
+    } else if(aggregation == "ema"){
+        if(param <= 0 || param > 1){
+            throw std::invalid_argument("ema alpha must be in (0, 1]");
+        }
+    } else if(aggregation == "worstk"){
+        if(param < 1){
+            throw std::invalid_argument("worstk needs k >= 1");
+        }
+    } else if(aggregation == "quantile"){
+        checkAggregation(aggregation, param);
+    } else {
+        throw std::invalid_argument("unknown seed history aggregation: " + aggregation +
+                                    " (use mean, ema, worstk or quantile)");
+    }
+}
+
+/**
+ * @class SeedHistory
+ * @brief Fixed-capacity ring buffer of episode returns of one individual.
+ *
+ * @details
+ * Once the buffer is full, every new return overwrites the oldest one. Aggregations:
+ *
+ * - **mean**: mean of all stored returns
+ * - **ema**: exponential moving average in chronological order,
+ *   e = alpha * return + (1 - alpha) * e, starting with the oldest return
+ * - **worstk**: mean of the k lowest returns (robust against lucky seeds)
+ * - **quantile**: q-quantile of the stored returns (see aggregateScores())
+ */
+class SeedHistory {
+    public:
+        /**
+         * @param _capacity maximum number of stored returns (0 = no history)
+         */
+        explicit SeedHistory(size_t _capacity = 0):
+            values(_capacity)
+        {}
+
+        /**
+         * @brief Changes the capacity and keeps the newest returns.
+         */
+        void setCapacity(size_t capacity){
+            std::vector<float> ordered = toVector();
+            if(ordered.size() > capacity){
+                ordered.erase(ordered.begin(), ordered.end() - capacity);
+            }
+            values.assign(capacity, 0);
+            head = 0;
+            count = 0;
+            for(float v : ordered){
+                push(v);
+            }
+        }
+
+        /** @brief Appends a return (overwrites the oldest one if the buffer is full). */
+        void push(float value){
+            if(values.empty()){
+                return;
+            }
+            values[head] = value;
+            head = (head + 1) % values.size();
+            count = std::min(count + 1, values.size());
+        }
+
+        /** @brief Removes all returns. */
+        void clear(){
+            head = 0;
+            count = 0;
+        }
+
+        size_t size() const { return count; } /**< number of stored returns */
+        size_t capacity() const { return values.size(); } /**< maximum number of stored returns */
+
+        /** @brief Stored returns from the oldest to the newest. */
+        std::vector<float> toVector() const {
+            std::vector<float> ordered;
+            ordered.reserve(count);
+            size_t first = (head + values.size() - count) % std::max<size_t>(values.size(), 1);
+            for(size_t i=0; i<count; i++){
+                ordered.push_back(values[(first + i) % values.size()]);
+            }
+            return ordered;
+        }
+
+        /**
+         * @brief Aggregates the stored returns.
+         * @param aggregation "mean", "ema", "worstk" or "quantile"
+         * @param param alpha (ema), k (worstk) or q (quantile)
+         * @return aggregated return (0 for an empty history)
+         */
+        float aggregate(const std::string& aggregation, float param = 0.5) const {
+            std::vector<float> ordered = toVector();
+            if(ordered.empty()){
+                return 0;
+            }
+            if(aggregation == "mean" || aggregation == "quantile"){
+                return aggregateScores(std::move(ordered), aggregation, param);
+            } else if(aggregation == "ema"){
+                double e = ordered[0];
+                for(size_t i=1; i<ordered.size(); i++){
+                    e = param * ordered[i] + (1 - param) * e;
+                }
+                return e;
+            } else if(aggregation == "worstk"){
+                size_t k = std::min(static_cast<size_t>(param), ordered.size());
+                std::partial_sort(ordered.begin(), ordered.begin() + k, ordered.end());
+                double sum = 0;
+                for(size_t i=0; i<k; i++){
+                    sum += ordered[i];
+                }
+                return sum / k;
+            }
+            throw std::invalid_argument("unknown seed history aggregation: " + aggregation);
+        }
+
+    private:
+        std::vector<float> values;
+        size_t head = 0; // next slot to write
+        size_t count = 0;
+};
+
+/**
+ * @class SeedPool
+ * @brief Evaluation seeds of a population: fixed anchor seeds plus a rolling pool.
+ *
+ * @details
+ * Anchor seeds are evaluated in every generation and make fitness values comparable
+ * over time; the rolling seeds are replaced step by step (oldest first) so that the
+ * networks do not overfit a fixed set of episodes.
+ */
+class SeedPool {
+    public:
+        std::vector<int> anchors; /**< seeds evaluated in every generation */
+        std::vector<int> rolling; /**< seeds that are replaced by roll() */
+        int maxSeed = 1000000; /**< new seeds are drawn uniformly from [0, maxSeed] */
+
+        /** @brief Anchor seeds followed by the rolling seeds. */
+        std::vector<int> seeds() const {
+            std::vector<int> all = anchors;
+            all.insert(all.end(), rolling.begin(), rolling.end());
+            return all;
+        }
+
+        /**
+         * @brief Replaces the n oldest rolling seeds by new random seeds.
+         * @param generator random generator
+         * @param n number of seeds to replace (at most the size of the rolling pool)
+         */
+        void roll(std::mt19937_64& generator, size_t n = 1){
+            std::uniform_int_distribution<int> distribution(0, maxSeed);
+            n = std::min(n, rolling.size());
+            std::rotate(rolling.begin(), rolling.begin() + n, rolling.end()); // oldest seeds to the back
+            for(size_t i=rolling.size()-n; i<rolling.size(); i++){
+                rolling[i] = distribution(generator);
+            }
+        }
+};
+
+#endif
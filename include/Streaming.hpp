@@ -0,0 +1,100 @@
+#ifndef STREAMING_HPP
+#define STREAMING_HPP
+#include <cstdint>
+#include <deque>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @file Streaming.hpp
+ * @brief Sliding data window and per-individual state for incremental fitness on streaming data.
+ *
+ * @details
+ * For continual evolution on streaming data (e.g. new bars of a price series),
+ * the population is evaluated on a sliding window of the most recent rows.
+ * Instead of re-running the traversal over the whole window after each update,
+ * every individual keeps a checkpoint of its traversal state together with the
+ * per-row contributions to its fitness (see StreamState). An update then only
+ * traverses the appended rows and subtracts the contributions of the expired rows.
+ *
+ * @see Network::fitStreamingAccuracy(), Population::streamingAccuracy()
+ */
+
+/**
+ * @class StreamWindow
+ * @brief Fixed-capacity sliding window of labeled rows with absolute row indices.
+ *
+ * @details
+ * Rows are appended at the back; if the capacity is exceeded the oldest rows expire.
+ * Every row keeps its absolute index (number of rows appended before it), which
+ * allows individuals to find out which rows they have already seen.
+ */
+class StreamWindow {
+    public:
+        /**
+         * @param _capacity maximum number of rows in the window
+         */
+        explicit StreamWindow(size_t _capacity):
+            capacity(_capacity)
+        {
+            if(capacity == 0){
+                throw std::invalid_argument("capacity of a StreamWindow must be > 0");
+            }
+        }
+
+        /**
+         * @brief Appends rows and labels; the oldest rows expire if the window is full.
+         * @param X feature rows
+         * @param y labels (same length as X)
+         */
+        void append(const std::vector<std::vector<float>>& X, const std::vector<int>& y){
+            if(X.size() != y.size()){
+                throw std::invalid_argument("X and y must have the same number of rows");
+            }
+            for(size_t i=0; i<X.size(); i++){
+                rows.push_back(X[i]);
+                labels.push_back(y[i]);
+                if(rows.size() > capacity){
+                    rows.pop_front();
+                    labels.pop_front();
+                    first ++;
+                }
+            }
+        }
+
+        size_t firstRow() const { return first; } /**< absolute index of the oldest row in the window */
+        size_t endRow() const { return first + rows.size(); } /**< absolute index behind the newest row */
+        size_t size() const { return rows.size(); } /**< number of rows in the window */
+        size_t maxSize() const { return capacity; } /**< capacity of the window */
+
+        const std::vector<float>& row(size_t absolute) const { return rows[absolute - first]; } /**< row by absolute index */
+        int label(size_t absolute) const { return labels[absolute - first]; } /**< label by absolute index */
+
+    private:
+        size_t capacity;
+        size_t first = 0;
+        std::deque<std::vector<float>> rows;
+        std::deque<int> labels;
+};
+
+/**
+ * @struct StreamState
+ * @brief Checkpointed traversal state and per-row fitness contributions of one individual.
+ *
+ * @details
+ * The state travels with the network through selection (it is a member of Network),
+ * and is invalidated by Network::genomeChanged() whenever a genetic operator modifies
+ * the genome. An invalid state forces a full evaluation (re-anchoring) of the window.
+ */
+struct StreamState {
+    bool valid = false; /**< false if the window must be evaluated from scratch */
+    int currentNodeID = 0; /**< node to continue the traversal from */
+    int nConsecutiveP = 0; /**< consecutive processing nodes at the checkpoint */
+    size_t firstRow = 0; /**< absolute index of the row of contributions.front() */
+    size_t nextRow = 0; /**< absolute index of the next row to evaluate */
+    size_t rowsSinceAnchor = 0; /**< rows evaluated incrementally since the last full evaluation */
+    size_t correct = 0; /**< sum of contributions */
+    std::deque<uint8_t> contributions; /**< per-row contribution (1 = correct decision) */
+};
+
+#endif
@@ -0,0 +1,351 @@
+#ifndef SURROGATE_HPP
+#define SURROGATE_HPP
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "Parallel.hpp"
+#include "Population.hpp"
+#include "PopulationView.hpp"
+
+/**
+ * @file Surrogate.hpp
+ * @brief Surrogate-assisted pre-screening of offspring before the full evaluation.
+ *
+ * @details
+ * On expensive fitness functions (gymnasium, multi-series backtests) many offspring
+ * are obviously poor. A Surrogate predicts the fitness of every individual from cheap
+ * features (see surrogateFeatures()) with a k-nearest-neighbour regressor that is
+ * trained online on the individuals evaluated so far. Only the predicted top fraction
+ * (plus the elite) is evaluated with the real fitness:
+ *
+ * @code
+ * Surrogate surrogate(5, 2000);
+ * for(int g=0; g<generations; g++){
+ *     prescreenAndEvaluate(population, surrogate, probe, dMax, 0.3,
+ *                          [&](Population& p){ p.gymnasium(env, dMax, maxSteps, maxConsecutiveP, worstFitness, seed); },
+ *                          worstFitness);
+ *     population.tournamentSelection(2, 1);
+ *     ...
+ * }
+ * @endcode
+ */
+
+/**
+ * @brief Cheap features of a network for the surrogate.
+ *
+ * @details
+ * 1. number of inner nodes
+ * 2. number of inner nodes reachable from the start node
+ * 3. fraction of judgment nodes among the reachable nodes
+ * 4. inherited fitness: after selection an offspring still carries the fitness of its
+ *    parent (0 if the network was never evaluated)
+ * 5. one decision per row of the probe set (-1 from the row on which the network
+ *    becomes invalid, see Network::traversePathInto())
+ *
+ * The probe traversal updates the used flags of the nodes like any other traversal.
+ *
+ * @param network network to describe
+ * @param probe small probe set of observations
+ * @param dMax maximum consecutive judgment nodes per decision
+ * @return 4 + probe.size() features
+ */
+inline std::vector<float> surrogateFeatures(
+        Network& network,
+        const std::vector<std::vector<float>>& probe,
+        int dMax
+        ){
+    std::vector<float> features(4 + probe.size());
+    features[0] = network.innerNodes.size();
+
+    std::vector<char> reachable(network.innerNodes.size(), 0);
+    std::vector<int> stack = {network.startNode.edges[0]};
+    size_t nReachable = 0;
+    size_t nJudgment = 0;
+    while(!stack.empty()){
+        int id = stack.back();
+        stack.pop_back();
+        if(id < 0 || static_cast<size_t>(id) >= reachable.size() || reachable[id]){
+            continue;
+        }
+        reachable[id] = 1;
+        nReachable++;
+        const Node& node = network.innerNodes[id];
+        if(node.type == "J"){
+            nJudgment++;
+        }
+        stack.insert(stack.end(), node.edges.begin(), node.edges.end());
+    }
+    features[1] = nReachable;
+    features[2] = nReachable == 0 ? 0 : static_cast<float>(nJudgment) / nReachable;
+    features[3] = std::isfinite(network.fitness) && network.fitness != std::numeric_limits<float>::lowest()
+        ? network.fitness : 0;
+    if(!probe.empty()){
+        network.traversePathInto(probe, dMax, features.data() + 4);
+    }
+    return features;
+}
+
+/**
+ * @class Surrogate
+ * @brief Online k-nearest-neighbour fitness regressor for pre-screening offspring.
+ *
+ * @details
+ * Training samples (features, fitness) are kept in a ring buffer of fixed capacity, so
+ * the model follows the moving population. fit() standardises the features with the
+ * mean and standard deviation of the stored samples; predict() returns the
+ * inverse-distance weighted mean fitness of the k nearest samples.
+ *
+ * A generation is screened in two steps, so that the full evaluation can be any
+ * callable (including Python code on a Population.subset()):
+ * 1. screen() computes the features of all individuals, keeps the predicted top
+ *    fraction and the elite, and assigns worstFitness to the others
+ * 2. update() adds the evaluated individuals as training samples and refits the model
+ */
+class Surrogate {
+    public:
+        /**
+         * @param _k number of neighbours
+         * @param _capacity maximum number of stored samples (the oldest are replaced)
+         * @param _minSamples screen() evaluates everything until this many samples are stored
+         *  (0 = k)
+         */
+        explicit Surrogate(size_t _k = 5, size_t _capacity = 2000, size_t _minSamples = 0):
+            k(_k),
+            capacity(_capacity),
+            minSamples(_minSamples == 0 ? _k : _minSamples)
+        {
+            if(k == 0 || capacity == 0){
+                throw std::invalid_argument("a surrogate needs k >= 1 and capacity >= 1");
+            }
+        }
+
+        /**
+         * @brief Adds a training sample.
+         * @throws std::invalid_argument if the number of features differs from the stored samples
+         */
+        void add(const std::vector<float>& features, float fitness){
+            if(!samples.empty() && features.size() != samples[0].size()){
+                throw std::invalid_argument("all surrogate samples need the same number of features");
+            }
+            if(samples.size() < capacity){
+                samples.push_back(features);
+                targets.push_back(fitness);
+            } else {
+                samples[head] = features;
+                targets[head] = fitness;
+                head = (head + 1) % capacity;
+            }
+        }
+
+        /** @brief Recomputes the standardisation of the features from the stored samples. */
+        void fit(){
+            size_t nFeatures = samples.empty() ? 0 : samples[0].size();
+            mean.assign(nFeatures, 0);
+            scale.assign(nFeatures, 1);
+            if(samples.empty()){
+                return;
+            }
+            std::vector<double> sum(nFeatures, 0);
+            std::vector<double> sumSq(nFeatures, 0);
+            for(const auto& sample : samples){
+                for(size_t f=0; f<nFeatures; f++){
+                    sum[f] += sample[f];
+                    sumSq[f] += static_cast<double>(sample[f]) * sample[f];
+                }
+            }
+            for(size_t f=0; f<nFeatures; f++){
+                double m = sum[f] / samples.size();
+                double variance = sumSq[f] / samples.size() - m * m;
+                mean[f] = m;
+                scale[f] = variance > 1e-12 ? 1.0 / std::sqrt(variance) : 1.0;
+            }
+        }
+
+        /**
+         * @brief Predicted fitness of a feature vector.
+         * @throws std::runtime_error if the model has no samples or was not fitted
+         */
+        float predict(const std::vector<float>& features) const {
+            if(samples.empty() || mean.size() != samples[0].size()){
+                throw std::runtime_error("surrogate has no fitted samples; call add() and fit() first");
+            }
+            if(features.size() != mean.size()){
+                throw std::invalid_argument("feature vector does not match the surrogate samples");
+            }
+            size_t kk = std::min(k, samples.size());
+            std::vector<std::pair<double, size_t>> distances(samples.size());
+            for(size_t s=0; s<samples.size(); s++){
+                double d = 0;
+                for(size_t f=0; f<features.size(); f++){
+                    double diff = (features[f] - samples[s][f]) * scale[f];
+                    d += diff * diff;
+                }
+                distances[s] = {d, s};
+            }
+            std::partial_sort(distances.begin(), distances.begin() + kk, distances.end());
+            double weightSum = 0;
+            double value = 0;
+            for(size_t i=0; i<kk; i++){
+                if(distances[i].first == 0){ // exact match: mean of all exact matches
+                    weightSum = 0;
+                    value = 0;
+                    for(size_t j=0; j<kk && distances[j].first == 0; j++){
+                        value += targets[distances[j].second];
+                        weightSum += 1;
+                    }
+                    break;
+                }
+                double w = 1.0 / std::sqrt(distances[i].first);
+                value += w * targets[distances[i].second];
+                weightSum += w;
+            }
+            return value / weightSum;
+        }
+
+        /**
+         * @brief Selects the individuals that get the full evaluation.
+         *
+         * @details
+         * Computes surrogateFeatures() of all individuals (in parallel, nThreads of the
+         * population) and keeps them for update(). Until minSamples samples are stored all
+         * individuals are selected. Otherwise the ceil(fraction * ni) individuals with the
+         * highest predicted fitness and all elite individuals are selected; the others
+         * receive worstFitness and are not evaluated.
+         *
+         * @param population population to screen
+         * @param probe probe set of observations for the decision features
+         * @param dMax maximum consecutive judgment nodes per decision
+         * @param fraction fraction of the population to evaluate, in (0, 1]
+         * @param worstFitness fitness of the screened-out individuals
+         * @return ascending indices of the individuals to evaluate
+         */
+        std::vector<int> screen(
+                Population& population,
+                const std::vector<std::vector<float>>& probe,
+                int dMax,
+                float fraction,
+                float worstFitness
+                ){
+            if(!(fraction > 0 && fraction <= 1)){
+                throw std::invalid_argument("surrogate fraction must be in (0, 1]");
+            }
+            size_t n = population.individuals.size();
+            pending.assign(n, {});
+            parallelFor(n, population.nThreads, [&](size_t i){
+                pending[i] = surrogateFeatures(population.individuals[i], probe, dMax);
+            }, population.chunk);
+            std::vector<int> selected;
+            if(samples.size() < minSamples || (!samples.empty() && pending[0].size() != samples[0].size())){
+                for(size_t i=0; i<n; i++){
+                    selected.push_back(i);
+                }
+                return selected;
+            }
+            std::vector<float> predicted(n);
+            parallelFor(n, population.nThreads, [&](size_t i){
+                predicted[i] = predict(pending[i]);
+            }, population.chunk);
+            std::vector<int> order(n);
+            for(size_t i=0; i<n; i++){
+                order[i] = i;
+            }
+            size_t keep = std::min<size_t>(n, std::ceil(fraction * n));
+            std::stable_sort(order.begin(), order.end(), [&](int a, int b){
+                return predicted[a] > predicted[b];
+            });
+            std::vector<char> chosen(n, 0);
+            for(size_t i=0; i<keep; i++){
+                chosen[order[i]] = 1;
+            }
+            for(int e : population.indicesElite){
+                if(e >= 0 && static_cast<size_t>(e) < n){
+                    chosen[e] = 1;
+                }
+            }
+            for(size_t i=0; i<n; i++){
+                if(chosen[i]){
+                    selected.push_back(i);
+                } else {
+                    population.individuals[i].fitness = worstFitness;
+                }
+            }
+            nScreenedOut += n - selected.size();
+            return selected;
+        }
+
+        /**
+         * @brief Trains the surrogate on the evaluated individuals of the last screen().
+         * @param population screened population (after the full evaluation)
+         * @param evaluated indices returned by screen()
+         */
+        void update(const Population& population, const std::vector<int>& evaluated){
+            if(pending.size() != population.individuals.size()){
+                throw std::runtime_error("update() needs the population of the last screen()");
+            }
+            for(int i : evaluated){
+                if(i < 0 || static_cast<size_t>(i) >= pending.size() || pending[i].empty()){
+                    throw std::invalid_argument("update() needs the indices returned by screen()");
+                }
+                add(pending[i], population.individuals[i].fitness);
+            }
+            pending.clear();
+            fit();
+        }
+
+        size_t size() const { return samples.size(); } /**< number of stored samples */
+        size_t screenedOut() const { return nScreenedOut; } /**< individuals not evaluated so far (saved evaluations) */
+
+        size_t k; /**< number of neighbours */
+        size_t capacity; /**< maximum number of stored samples */
+        size_t minSamples; /**< screen() evaluates everything until this many samples are stored */
+
+    private:
+        std::vector<std::vector<float>> samples;
+        std::vector<float> targets;
+        size_t head = 0; // oldest sample once the buffer is full
+        std::vector<double> mean;
+        std::vector<double> scale;
+        std::vector<std::vector<float>> pending; // features of the last screen()
+        size_t nScreenedOut = 0;
+};
+
+/**
+ * @brief Screens a population, evaluates the selected individuals and retrains the surrogate.
+ *
+ * @details
+ * The selected individuals are evaluated on a PopulationView (no copies); if all are
+ * selected, evaluate is called on the population itself.
+ *
+ * @param population population to evaluate
+ * @param surrogate surrogate model (updated)
+ * @param probe probe set for the decision features
+ * @param dMax maximum consecutive judgment nodes per decision
+ * @param fraction fraction of the population to evaluate, in (0, 1]
+ * @param evaluate full fitness evaluation of a population
+ * @param worstFitness fitness of the screened-out individuals
+ * @return indices of the evaluated individuals
+ */
+inline std::vector<int> prescreenAndEvaluate(
+        Population& population,
+        Surrogate& surrogate,
+        const std::vector<std::vector<float>>& probe,
+        int dMax,
+        float fraction,
+        const std::function<void(Population&)>& evaluate,
+        float worstFitness
+        ){
+    std::vector<int> selected = surrogate.screen(population, probe, dMax, fraction, worstFitness);
+    if(selected.size() == population.individuals.size()){
+        evaluate(population);
+    } else {
+        PopulationView view(population, selected);
+        evaluate(view.population());
+    }
+    surrogate.update(population, selected);
+    return selected;
+}
+
+#endif
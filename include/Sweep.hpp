@@ -0,0 +1,208 @@
+#ifndef SWEEP_HPP
+#define SWEEP_HPP
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Parallel.hpp"
+#include "Population.hpp"
+
+/**
+ * @file Sweep.hpp
+ * @brief Hyperparameter sweeps: many populations evolved concurrently with successive halving.
+ *
+ * @details
+ * runSweep() builds one Population per SweepConfig and evolves all of them on one
+ * shared pool of threads. Parallelism is across populations (each population is
+ * evaluated serially), so the data set is shared read-only by all configurations
+ * and converted only once.
+ *
+ * Hopeless configurations are abandoned by successive halving: after the first rung
+ * of rungGenerations generations only the best 1/eta of the configurations (by best
+ * fitness) continue; the rung length is multiplied by eta after every rung, until the
+ * survivors reach the full number of generations.
+ */
+
+/**
+ * @struct SweepConfig
+ * @brief Hyperparameters of one population of a sweep.
+ */
+struct SweepConfig {
+    std::string name; /**< label of the configuration in the results */
+    int seed = 123; /**< seed of the population */
+    unsigned int ni = 100; /**< number of individuals */
+    unsigned int jn = 1; /**< initial number of judgment nodes */
+    unsigned int jnf = 0; /**< number of judgment node functions (0 = number of features, i.e. minF.size()) */
+    unsigned int pn = 2; /**< initial number of processing nodes */
+    unsigned int pnf = 2; /**< number of processing node functions */
+    bool fractalJudgment = false; /**< fractal judgment nodes */
+    int tournamentSize = 2; /**< tournament size */
+    int nElite = 1; /**< number of elite individuals */
+    float probCrossover = 0.05; /**< crossover probability */
+    std::string crossoverType = ""; /**< crossover type (see Population::crossover()) */
+    float probEdgeInner = 0.03; /**< edge mutation probability of inner nodes */
+    float probEdgeStart = 0.03; /**< edge mutation probability of the start node */
+    float probBoundary = 0.1; /**< probability of the normal boundary mutation (0 = off) */
+    float sigmaBoundary = 0.01; /**< sigma of the normal boundary mutation */
+    bool addDelNodes = true; /**< add/delete nodes each generation */
+};
+
+/**
+ * @struct SweepOptions
+ * @brief Budget and scheduling of a sweep.
+ */
+struct SweepOptions {
+    int generations = 100; /**< generations of the configurations that survive all rungs */
+    int rungGenerations = 10; /**< generations of the first rung (>= generations disables halving) */
+    float eta = 2; /**< 1/eta of the configurations survive a rung; the rung length grows by eta */
+    unsigned int nThreads = 0; /**< threads of the shared pool (0 = all hardware threads) */
+};
+
+/**
+ * @struct SweepResult
+ * @brief Outcome of one configuration of a sweep.
+ */
+struct SweepResult {
+    size_t config = 0; /**< index of the configuration */
+    std::string name; /**< name of the configuration */
+    int generations = 0; /**< completed generations */
+    bool abandoned = false; /**< true if successive halving stopped the configuration */
+    float bestFitness = 0; /**< best fitness of the last completed generation */
+    std::vector<float> bestPerGeneration; /**< best fitness per generation */
+    std::vector<float> meanPerGeneration; /**< mean fitness per generation */
+    std::shared_ptr<Network> best; /**< best individual of the last completed generation */
+};
+
+/**
+ * @brief Runs one generation of the standard evolution loop.
+ *
+ * @details
+ * evaluate, tournament selection, crossover, add/delete nodes, edge mutation and
+ * normal boundary mutation.
+ *
+ * @param population population to evolve
+ * @param config hyperparameters
+ * @param evaluate fitness function of the population
+ * @param minF minimum per feature (for new nodes)
+ * @param maxF maximum per feature (for new nodes)
+ */
+inline void evolveGeneration(
+        Population& population,
+        const SweepConfig& config,
+        const std::function<void(Population&)>& evaluate,
+        std::vector<float>& minF,
+        std::vector<float>& maxF
+        ){
+    evaluate(population);
+    population.tournamentSelection(config.tournamentSize, config.nElite);
+    population.crossover(config.probCrossover, config.crossoverType);
+    if(config.addDelNodes){
+        population.callAddDelNodes(minF, maxF);
+    }
+    population.callEdgeMutation(config.probEdgeInner, config.probEdgeStart);
+    if(config.probBoundary > 0){
+        population.callBoundaryMutationNormal(config.probBoundary, config.sigmaBoundary, false);
+    }
+}
+
+/**
+ * @brief Evolves one population per configuration with successive halving.
+ *
+ * @details
+ * evaluate is called concurrently for different populations and must therefore only
+ * read shared data (e.g. [&](Population& p){ p.accuracy(X, y, dMax, 0); }). The
+ * populations are evaluated with nThreads = 1 each; the parallelism comes from the
+ * shared pool over the active configurations.
+ *
+ * @param configs hyperparameter configurations
+ * @param evaluate fitness function of one population
+ * @param minF minimum per feature (boundaries of the judgment nodes)
+ * @param maxF maximum per feature
+ * @param options generations, rung schedule and threads
+ * @return one result per configuration, in the order of configs
+ * @throws std::invalid_argument for an empty sweep or an invalid schedule
+ */
+inline std::vector<SweepResult> runSweep(
+        const std::vector<SweepConfig>& configs,
+        const std::function<void(Population&)>& evaluate,
+        const std::vector<float>& minF,
+        const std::vector<float>& maxF,
+        const SweepOptions& options = {}
+        ){
+    if(configs.empty()){
+        throw std::invalid_argument("a sweep needs at least one configuration");
+    }
+    if(options.generations < 1 || options.rungGenerations < 1 || options.eta <= 1){
+        throw std::invalid_argument("a sweep needs generations >= 1, rungGenerations >= 1 and eta > 1");
+    }
+    if(minF.size() != maxF.size()){
+        throw std::invalid_argument("minF and maxF must have the same length");
+    }
+
+    struct Run {
+        std::unique_ptr<Population> population;
+        std::vector<float> minF;
+        std::vector<float> maxF;
+    };
+    std::vector<Run> runs(configs.size());
+    std::vector<SweepResult> results(configs.size());
+    parallelFor(configs.size(), options.nThreads, [&](size_t c){
+        const SweepConfig& config = configs[c];
+        Run& run = runs[c];
+        run.minF = minF; // callAddDelNodes takes non-const references
+        run.maxF = maxF;
+        run.population = std::make_unique<Population>(config.seed, config.ni, config.jn,
+                                                      config.jnf == 0 ? minF.size() : config.jnf,
+                                                      config.pn, config.pnf, config.fractalJudgment);
+        run.population->nThreads = 1;
+        run.population->setAllNodeBoundaries(run.minF, run.maxF);
+        results[c].config = c;
+        results[c].name = config.name;
+    });
+
+    std::vector<size_t> active(configs.size());
+    for(size_t c=0; c<active.size(); c++){
+        active[c] = c;
+    }
+    double rung = options.rungGenerations;
+    while(true){
+        int target = std::min<double>(options.generations, std::round(rung));
+        parallelFor(active.size(), options.nThreads, [&](size_t a){
+            size_t c = active[a];
+            Population& population = *runs[c].population;
+            SweepResult& result = results[c];
+            for(; result.generations < target; result.generations++){
+                evolveGeneration(population, configs[c], evaluate, runs[c].minF, runs[c].maxF);
+                result.bestPerGeneration.push_back(population.bestFit);
+                result.meanPerGeneration.push_back(population.meanFitness);
+            }
+            result.bestFitness = population.bestFit;
+        });
+        if(target >= options.generations){
+            break;
+        }
+        // successive halving: keep the best ceil(n / eta) configurations
+        size_t keep = std::max<size_t>(1, std::ceil(active.size() / options.eta));
+        std::stable_sort(active.begin(), active.end(), [&](size_t a, size_t b){
+            return results[a].bestFitness > results[b].bestFitness;
+        });
+        for(size_t a=keep; a<active.size(); a++){
+            results[active[a]].abandoned = true;
+        }
+        active.resize(keep);
+        rung *= options.eta;
+    }
+
+    for(size_t c=0; c<configs.size(); c++){
+        Population& population = *runs[c].population;
+        if(!population.indicesElite.empty()){
+            results[c].best = std::make_shared<Network>(population.individuals[population.indicesElite[0]]);
+        }
+    }
+    return results;
+}
+
+#endif
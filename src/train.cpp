@@ -0,0 +1,297 @@
+/**
+ * @file train.cpp
+ * @brief fracnetics-train: native training jobs configured by an INI file.
+ *
+ * @details
+ * Usage:
+ *
+ * @code
+ * fracnetics-train <config.ini> [--resume] [--set section.key=value ...]
+ * @endcode
+ *
+ * The job reads CSV or binary data (see Data::readBinary()), evolves a population with
+ * accuracy, cartpole, backtest or native (FitnessRegistry) fitness on nThreads threads
+ * (run.threads = auto times the first generations and keeps the fastest setting),
+ * appends one line per generation to a metrics CSV and writes periodic checkpoints.
+ * With --resume (or run.resume = true) the run continues from the checkpoint if it
+ * exists. See examples/train.ini for all keys.
+ */
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../include/Autotuner.hpp"
+#include "../include/Checkpoint.hpp"
+#include "../include/Config.hpp"
+#include "../include/Data.hpp"
+#include "../include/FitnessRegistry.hpp"
+#include "../include/Population.hpp"
+
+namespace {
+
+struct Dataset {
+    std::vector<std::vector<float>> X;
+    std::vector<float> target;
+    std::vector<float> minX;
+    std::vector<float> maxX;
+};
+
+Dataset loadDataset(const Config& config){
+    Dataset dataset;
+    Data data;
+    std::string path = config.get<std::string>("data.path", "");
+    if(!path.empty()){
+        std::string format = config.get<std::string>("data.format", "csv");
+        if(format == "csv"){
+            if(!std::filesystem::exists(path)){
+                throw std::runtime_error("cannot read data file " + path);
+            }
+            data.readCSV(path, config.get<bool>("data.header", true));
+        } else if(format == "binary"){
+            data.readBinary(path);
+        } else {
+            throw std::invalid_argument("unknown data.format: " + format + " (use csv or binary)");
+        }
+        if(data.dt.empty()){
+            throw std::runtime_error("data file " + path + " contains no rows");
+        }
+        int target = config.get<int>("data.target", 0);
+        std::vector<int> features = config.getList<int>("data.features");
+        int nCols = data.dt[0].size();
+        if(features.empty()){
+            for(int c=0; c<nCols; c++){
+                if(c != target){
+                    features.push_back(c);
+                }
+            }
+        }
+        for(int c : features){
+            if(c < 0 || c >= nCols){
+                throw std::invalid_argument("data.features refers to a column outside of the data");
+            }
+        }
+        if(target < 0 || target >= nCols){
+            throw std::invalid_argument("data.target refers to a column outside of the data");
+        }
+        data.xySplit(target, features);
+        data.minMaxFeatures(data.X);
+        dataset.X = std::move(data.X);
+        dataset.target = std::move(data.y);
+        dataset.minX = std::move(data.minX);
+        dataset.maxX = std::move(data.maxX);
+    }
+    // explicit feature ranges (required for cartpole without data)
+    if(config.has("data.min") || config.has("data.max")){
+        dataset.minX = config.getList<float>("data.min");
+        dataset.maxX = config.getList<float>("data.max");
+    }
+    if(dataset.minX.empty() || dataset.minX.size() != dataset.maxX.size()){
+        throw std::invalid_argument("set data.path or data.min/data.max with one value per feature");
+    }
+    return dataset;
+}
+
+void evaluate(Population& population, const Config& config, const Dataset& dataset, const std::vector<int>& labels){
+    std::string mode = config.get<std::string>("fitness.mode", "accuracy");
+    int dMax = config.get<int>("fitness.dMax", 10);
+    int penalty = config.get<int>("fitness.penalty", 2);
+    if(mode == "accuracy"){
+        population.accuracy(dataset.X, labels, dMax, penalty);
+    } else if(mode == "cartpole"){
+        population.cartpole(dMax, penalty,
+                            config.get<int>("fitness.maxSteps", 500),
+                            config.get<int>("fitness.maxConsecutiveP", 2));
+    } else if(mode == "backtest"){
+        population.backtest(dataset.X, dataset.target,
+                            config.getList<float>("fitness.positions"),
+                            dMax,
+                            config.get<float>("fitness.worstFitness", -1000),
+                            config.get<float>("fitness.cost", 0),
+                            config.get<std::string>("fitness.metric", "sharpe"),
+                            config.get<float>("fitness.periodsPerYear", 252));
+    } else if(mode == "native"){
+        population.nativeFitness(config.require<std::string>("fitness.kernel"),
+                                 dataset.X, dataset.target, 1, dMax,
+                                 config.get<float>("fitness.worstFitness", 0));
+    } else {
+        throw std::invalid_argument("unknown fitness.mode: " + mode + " (use accuracy, cartpole, backtest or native)");
+    }
+}
+
+void mutateBoundaries(Population& population, const Config& config, const Dataset& dataset){
+    std::string type = config.get<std::string>("evolution.boundaryMutation", "normal");
+    float probability = config.get<float>("evolution.boundaryMutationProbability", 0.1);
+    float sigma = config.get<float>("evolution.boundaryMutationSigma", 0.01);
+    bool justUsedNodes = config.get<bool>("evolution.justUsedNodes", false);
+    if(type == "none"){
+        return;
+    } else if(type == "uniform"){
+        population.callBoundaryMutationUniform(probability, justUsedNodes);
+    } else if(type == "normal"){
+        population.callBoundaryMutationNormal(probability, sigma, justUsedNodes);
+    } else if(type == "networkSigma"){
+        population.callBoundaryMutationNetworkSizeDependingSigma(probability, sigma, justUsedNodes);
+    } else if(type == "edgeSigma"){
+        population.callBoundaryMutationEdgeSizeDependingSigma(probability, sigma, justUsedNodes);
+    } else if(type == "fractal"){
+        population.callBoundaryMutationFractal(probability, dataset.minX, dataset.maxX, justUsedNodes);
+    } else {
+        throw std::invalid_argument("unknown evolution.boundaryMutation: " + type +
+                                    " (use none, uniform, normal, networkSigma, edgeSigma or fractal)");
+    }
+}
+
+int run(const Config& config, bool resume){
+    for(const std::string& plugin : config.getList<std::string>("fitness.plugin")){
+        loadFitnessPlugin(plugin);
+    }
+    Dataset dataset = loadDataset(config);
+    std::vector<int> labels(dataset.target.begin(), dataset.target.end());
+
+    Population population(
+            config.get<int>("population.seed", 123),
+            config.get<unsigned int>("population.individuals", 100),
+            config.get<unsigned int>("population.jn", 1),
+            config.get<unsigned int>("population.jnf", dataset.minX.size()),
+            config.get<unsigned int>("population.pn", 2),
+            config.get<unsigned int>("population.pnf", 2),
+            config.get<bool>("population.fractalJudgment", false)
+            );
+    std::unique_ptr<Autotuner> tuner;
+    if(config.get<std::string>("run.threads", "0") == "auto"){
+        tuner = std::make_unique<Autotuner>(Autotuner::defaultCandidates(population.individuals.size()),
+                                            config.get<size_t>("run.autotuneTrials", 1));
+    } else {
+        population.nThreads = config.get<unsigned int>("run.threads", 0);
+    }
+    population.setAllNodeBoundaries(dataset.minX, dataset.maxX);
+    population.budget.maxNodes = config.get<size_t>("evolution.maxNodes", 0);
+    population.budget.maxBytes = config.get<size_t>("evolution.maxBytes", 0);
+
+    int generations = config.get<int>("evolution.generations", 100);
+    int tournamentSize = config.get<int>("evolution.tournamentSize", 2);
+    int nElite = config.get<int>("evolution.elite", 1);
+    float probCrossover = config.get<float>("evolution.crossoverProbability", 0.05);
+    std::string crossoverType = config.get<std::string>("evolution.crossoverType", "");
+    float probEdgeInner = config.get<float>("evolution.edgeMutationInner", 0.03);
+    float probEdgeStart = config.get<float>("evolution.edgeMutationStart", 0.03);
+    bool addDelNodes = config.get<bool>("evolution.addDelNodes", true);
+    int noImprovementLimit = config.get<int>("evolution.noImprovementLimit", 0);
+
+    std::string checkpointPath = config.get<std::string>("run.checkpoint", "");
+    int checkpointInterval = config.get<int>("run.checkpointInterval", 10);
+    std::string metricsPath = config.get<std::string>("run.metrics", "");
+
+    int start = 0;
+    if(resume && !checkpointPath.empty() && std::filesystem::exists(checkpointPath)){
+        start = loadCheckpoint(population, checkpointPath);
+        std::cout << "resumed from " << checkpointPath << " after generation " << start << std::endl;
+    }
+
+    std::ofstream metrics;
+    if(!metricsPath.empty()){
+        bool append = start > 0 && std::filesystem::exists(metricsPath);
+        metrics.open(metricsPath, append ? std::ios::app : std::ios::trunc);
+        if(!metrics){
+            throw std::runtime_error("cannot write metrics file " + metricsPath);
+        }
+        if(!append){
+            metrics << "generation,bestFitness,meanFitness,minFitness,bestNetworkSize,seconds" << std::endl;
+        }
+    }
+
+    float lastBest = 0;
+    int noImprovement = 0;
+    for(int g=start; g<generations; g++){
+        auto begin = std::chrono::steady_clock::now();
+        if(tuner){
+            bool wasLocked = tuner->locked();
+            tuner->evaluate(population, [&](Population& p){ evaluate(p, config, dataset, labels); });
+            if(!wasLocked && tuner->locked()){
+                const AutotuneStats& stats = tuner->stats();
+                std::cout << "autotuner: threads " << tuner->best().nThreads << ", chunk " << tuner->best().chunk <<
+                    " (" << stats.seconds[stats.best] << " s per evaluation, " << stats.speedup <<
+                    "x speedup over the slowest candidate)" << std::endl;
+            }
+        } else {
+            evaluate(population, config, dataset, labels);
+        }
+        population.tournamentSelection(tournamentSize, nElite);
+        const Network& best = population.individuals[population.indicesElite[0]];
+        size_t bestSize = best.innerNodes.size();
+        population.crossover(probCrossover, crossoverType);
+        if(addDelNodes){
+            population.callAddDelNodes(dataset.minX, dataset.maxX);
+        }
+        population.callEdgeMutation(probEdgeInner, probEdgeStart);
+        mutateBoundaries(population, config, dataset);
+        std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - begin;
+
+        std::cout << "Generation: " << g <<
+            " BestFit: " << population.bestFit <<
+            " MeanFitness: " << population.meanFitness <<
+            " MinFitness: " << population.minFitness <<
+            " NetworkSize Best Ind: " << bestSize << std::endl;
+        if(metrics.is_open()){
+            metrics << g << "," << population.bestFit << "," << population.meanFitness << "," <<
+                population.minFitness << "," << bestSize << "," << seconds.count() << std::endl;
+        }
+        if(!checkpointPath.empty() && checkpointInterval > 0 &&
+           ((g + 1) % checkpointInterval == 0 || g + 1 == generations)){
+            saveCheckpoint(population, g + 1, checkpointPath);
+        }
+
+        if(noImprovementLimit > 0){
+            noImprovement = g > start && population.bestFit == lastBest ? noImprovement + 1 : 0;
+            lastBest = population.bestFit;
+            if(noImprovement >= noImprovementLimit){
+                std::cout << "no improvement for " << noImprovementLimit << " generations" << std::endl;
+                if(!checkpointPath.empty()){
+                    saveCheckpoint(population, g + 1, checkpointPath);
+                }
+                break;
+            }
+        }
+    }
+    return 0;
+}
+
+void usage(){
+    std::cerr << "usage: fracnetics-train <config.ini> [--resume] [--set section.key=value ...]" << std::endl;
+}
+
+}
+
+int main(int argc, char** argv){
+    if(argc < 2){
+        usage();
+        return 2;
+    }
+    try {
+        Config config = Config::fromFile(argv[1]);
+        bool resume = false;
+        for(int i=2; i<argc; i++){
+            std::string arg = argv[i];
+            if(arg == "--resume"){
+                resume = true;
+            } else if(arg == "--set" && i+1 < argc){
+                std::string assignment = argv[++i];
+                size_t eq = assignment.find('=');
+                if(eq == std::string::npos){
+                    throw std::invalid_argument("--set expects section.key=value");
+                }
+                config.set(assignment.substr(0, eq), assignment.substr(eq+1));
+            } else {
+                usage();
+                return 2;
+            }
+        }
+        return run(config, resume || config.get<bool>("run.resume", false));
+    } catch(const std::exception& e) {
+        std::cerr << "error: " << e.what() << std::endl;
+        return 1;
+    }
+}
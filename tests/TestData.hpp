@@ -0,0 +1,70 @@
+#ifndef TESTDATA_HPP
+#define TESTDATA_HPP
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "../include/Population.hpp"
+
+/**
+ * @file TestData.hpp
+ * @brief Synthetic datasets and populations shared by the unit tests.
+ *
+ * @details
+ * Most tests classify rows of uniform features in [0, 1) with a simple rule and a
+ * small population whose judgment nodes cover the unit box. The helpers draw the
+ * values of a row one after the other, so a seed always gives the same rows.
+ */
+namespace testdata {
+
+using Rows = std::vector<std::vector<float>>;
+
+/** @brief n rows of nFeatures values drawn uniformly from [0, 1). */
+inline Rows uniformRows(std::mt19937_64& generator, size_t n, size_t nFeatures = 2){
+    std::uniform_real_distribution<float> dist(0, 1);
+    Rows X(n, std::vector<float>(nFeatures));
+    for(auto& row : X){
+        for(float& value : row){
+            value = dist(generator);
+        }
+    }
+    return X;
+}
+
+/** @brief n rows of nFeatures values drawn uniformly from [0, 1) with a fresh generator. */
+inline Rows uniformRows(uint64_t seed, size_t n, size_t nFeatures = 2){
+    std::mt19937_64 generator(seed);
+    return uniformRows(generator, n, nFeatures);
+}
+
+/** @brief Label 1 for the rows satisfying a predicate, 0 otherwise. */
+template <typename Predicate>
+std::vector<int> labels(const Rows& X, Predicate predicate){
+    std::vector<int> y;
+    y.reserve(X.size());
+    for(const auto& row : X){
+        y.push_back(predicate(row) ? 1 : 0);
+    }
+    return y;
+}
+
+/** @brief Label 1 for the rows whose feature exceeds threshold. */
+inline std::vector<int> thresholdLabels(const Rows& X, size_t feature, double threshold){
+    return labels(X, [&](const std::vector<float>& row){ return row[feature] > threshold; });
+}
+
+/**
+ * @brief Population with jnf = nFeatures whose judgment nodes cover [0, 1] per feature.
+ * @see Population::Population(), Population::setAllNodeBoundaries()
+ */
+inline Population unitPopulation(int seed, unsigned int ni, unsigned int jn, unsigned int pn, unsigned int pnf,
+                                 bool fractal = false, size_t nFeatures = 2){
+    Population population(seed, ni, jn, nFeatures, pn, pnf, fractal);
+    std::vector<float> minF(nFeatures, 0);
+    std::vector<float> maxF(nFeatures, 1);
+    population.setAllNodeBoundaries(minF, maxF);
+    return population;
+}
+
+}
+
+#endif
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <vector>
+#include "../include/AsyncEvaluation.hpp"
+#include "TestData.hpp"
+
+class AsyncEvaluationTest : public ::testing::Test {
+protected:
+    std::vector<std::vector<float>> X;
+    std::vector<int> y;
+
+    void SetUp() override {
+        X = testdata::uniformRows(13, 300);
+        y = testdata::thresholdLabels(X, 0, 0.5);
+    }
+};
+
+TEST_F(AsyncEvaluationTest, CommittedResultsEqualSynchronousEvaluation) {
+    Population population = testdata::unitPopulation(1, 20, 4, 3, 2);
+    Population reference = population;
+    EvaluationHandle handle = evaluateAsync(population, [X = X, y = y](Population& p){
+        p.accuracy(X, y, 10, 0);
+    });
+    EXPECT_THROW(evaluateAsync(population, [](Population&){}), std::runtime_error);
+    handle.wait();
+    EXPECT_TRUE(handle.done());
+    EXPECT_FALSE(population.evaluating);
+    reference.accuracy(X, y, 10, 0);
+    for(size_t i=0; i<population.individuals.size(); i++){
+        EXPECT_FLOAT_EQ(population.individuals[i].fitness, reference.individuals[i].fitness);
+    }
+}
+
+TEST_F(AsyncEvaluationTest, ErrorsAreRaisedOnWaitAndReleaseThePopulation) {
+    Population population(1, 4, 4, 2, 3, 2, false);
+    EvaluationHandle handle = evaluateAsync(population, [](Population& p){
+        p.classificationMetric({}, {}, 10, "f1");
+    });
+    EXPECT_THROW(handle.wait(), std::invalid_argument);
+    EXPECT_FALSE(population.evaluating);
+    {
+        EvaluationHandle dropped = evaluateAsync(population, [](Population&){});
+    }
+    EXPECT_FALSE(population.evaluating); // destructor commits
+}
+
+TEST_F(AsyncEvaluationTest, ConflictingCallsFailWhileTheTaskRuns) {
+    Population population(1, 4, 4, 2, 3, 2, false);
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    EvaluationHandle handle = evaluateAsync(population, [released](Population&){
+        released.wait(); // holds the population lock until the test releases it
+    });
+    // the conflicting call must fail while the task still holds the lock
+    std::future<bool> conflict = std::async(std::launch::async, [&population](){
+        try {
+            lockIdlePopulation(population);
+        } catch(const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    });
+    bool returned = conflict.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+    EXPECT_FALSE(handle.done());
+    release.set_value();
+    EXPECT_TRUE(returned);
+    EXPECT_TRUE(conflict.get());
+    handle.wait();
+    EXPECT_NO_THROW(lockIdlePopulation(population));
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../include/Autotuner.hpp"
+#include "TestData.hpp"
+
+TEST(AutotunerTest, LocksInFastestCandidate) {
+    Population population(1, 8, 1, 2, 2, 2, false);
+    Autotuner tuner({{1, 1}, {2, 1}, {4, 8}}, 2);
+    std::vector<unsigned int> seen;
+    auto evaluate = [&](Population& p){
+        seen.push_back(p.nThreads);
+        std::this_thread::sleep_for(std::chrono::milliseconds(p.nThreads == 2 ? 1 : 15));
+    };
+    for(int g=0; g<6; g++){
+        EXPECT_FALSE(tuner.locked());
+        tuner.evaluate(population, evaluate);
+    }
+    // candidates are applied round-robin
+    EXPECT_EQ(seen, (std::vector<unsigned int>{1, 2, 4, 1, 2, 4}));
+    ASSERT_TRUE(tuner.locked());
+    EXPECT_EQ(tuner.stats().best, 1);
+    EXPECT_EQ(tuner.stats().trials, (std::vector<size_t>{2, 2, 2}));
+    EXPECT_GT(tuner.stats().speedup, 2);
+    EXPECT_EQ(population.nThreads, 2);
+    EXPECT_EQ(population.chunk, 1);
+
+    // once locked, the best setting is kept
+    tuner.evaluate(population, evaluate);
+    EXPECT_EQ(seen.back(), 2);
+    EXPECT_EQ(tuner.stats().trials[1], 2);
+}
+
+TEST(AutotunerTest, SettingsDoNotChangeResults) {
+    std::vector<std::vector<float>> X = testdata::uniformRows(4, 60);
+    std::vector<int> y = testdata::thresholdLabels(X, 0, 0.5);
+    Population population = testdata::unitPopulation(3, 40, 2, 2, 2);
+
+    std::vector<float> expected;
+    for(const ParallelSetting& setting : std::vector<ParallelSetting>{{1, 1}, {4, 1}, {4, 7}}){
+        population.nThreads = setting.nThreads;
+        population.chunk = setting.chunk;
+        population.accuracy(X, y, 10, 2);
+        std::vector<float> fitness;
+        for(const auto& network : population.individuals){
+            fitness.push_back(network.fitness);
+        }
+        if(expected.empty()){
+            expected = fitness;
+        }
+        EXPECT_EQ(fitness, expected);
+    }
+}
+
+TEST(AutotunerTest, DefaultCandidatesAndErrors) {
+    std::vector<ParallelSetting> candidates = Autotuner::defaultCandidates(1000);
+    ASSERT_FALSE(candidates.empty());
+    EXPECT_EQ(candidates[0].nThreads, 1);
+    EXPECT_EQ(candidates[0].chunk, 1);
+    EXPECT_THROW(Autotuner({}), std::invalid_argument);
+    EXPECT_THROW(Autotuner(candidates, 0), std::invalid_argument);
+    Population population(1, 4, 1, 2, 2, 2, false);
+    Autotuner tuner(candidates);
+    EXPECT_THROW(tuner.end(population), std::runtime_error);
+    EXPECT_THROW(tuner.evaluate(population, [](Population&){ throw std::runtime_error("fitness"); }), std::runtime_error);
+    EXPECT_THROW(tuner.end(population), std::runtime_error); // the failed timing is discarded
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+#include "../include/Population.hpp"
+#include "TestData.hpp"
+
+TEST(BacktestAccumulatorTest, ComputesReturnDrawdownTurnoverAndCosts) {
+    BacktestAccumulator backtest(0.01);
+    std::vector<double> positions = {1, 1, -1, 0};
+    std::vector<double> returns = {0.02, -0.05, -0.01, 0.03};
+    for(size_t i=0; i<positions.size(); i++){
+        backtest.update(positions[i], returns[i]);
+    }
+    // pnl: 0.02-0.01, -0.05, 0.01-0.02, 0-0.01
+    EXPECT_NEAR(backtest.netReturn(), 0.01 - 0.05 - 0.01 - 0.01, 1e-9);
+    EXPECT_NEAR(backtest.getTurnover(), 1 + 0 + 2 + 1, 1e-9);
+    EXPECT_NEAR(backtest.getMaxDrawdown(), 0.01 + 0.06, 1e-9); // peak 0.01, trough -0.06
+    EXPECT_LT(backtest.sharpe(252), 0);
+    EXPECT_THROW(backtest.score("profit", 252), std::invalid_argument);
+}
+
+TEST(BacktestAccumulatorTest, ConstantPnlHasZeroSharpe) {
+    BacktestAccumulator backtest;
+    for(int i=0; i<10; i++){
+        backtest.update(1, 0.01);
+    }
+    EXPECT_DOUBLE_EQ(backtest.sharpe(252), 0);
+    EXPECT_NEAR(backtest.score("calmar", 252), 0.1, 1e-9); // no drawdown -> net return
+}
+
+TEST(BacktestFitnessTest, ProcessingOnlyNetworkHoldsMappedPosition) {
+    auto generator = std::make_shared<std::mt19937_64>(1);
+    Network net(generator, 0, 1, 3, 1, false); // only processing nodes with f = 0
+    std::vector<std::vector<float>> X(5, std::vector<float>{0});
+    std::vector<float> returns = {0.01, 0.02, -0.01, 0.0, 0.03};
+    net.fitBacktest(X, returns, {-1}, 10, -100, 0, "return");
+    EXPECT_NEAR(net.fitness, -0.05, 1e-6); // short over all rows
+    ASSERT_EQ(net.fitnessValues.size(), 4);
+    EXPECT_NEAR(net.fitnessValues[3], 1, 1e-6); // one entry into the short position
+}
+
+TEST(ParallelFitnessTest, ParallelAccuracyEqualsSerial) {
+    std::vector<std::vector<float>> X = testdata::uniformRows(5, 300, 3);
+    std::vector<int> y = testdata::thresholdLabels(X, 1, 0.3);
+
+    Population serial = testdata::unitPopulation(11, 40, 4, 3, 2, false, 3);
+    Population parallel = serial;
+    serial.nThreads = 1;
+    parallel.nThreads = 4;
+    serial.accuracy(X, y, 10, 1);
+    parallel.accuracy(X, y, 10, 1);
+    for(size_t i=0; i<serial.individuals.size(); i++){
+        EXPECT_FLOAT_EQ(serial.individuals[i].fitness, parallel.individuals[i].fitness);
+    }
+}
+
+TEST(ParallelFitnessTest, ExceptionsAreRethrown) {
+    EXPECT_THROW(parallelFor(100, 4, [](size_t i){
+        if(i == 42){ throw std::runtime_error("fail"); }
+    }), std::runtime_error);
+}
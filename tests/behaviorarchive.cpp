@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "../include/Population.hpp"
+#include "TestData.hpp"
+
+TEST(BehaviorArchiveTest, SimilarBehaviourGetsCloseSignatures) {
+    BehaviorArchive archive(2, 16, 1);
+    std::mt19937_64 generator(3);
+    std::uniform_int_distribution<int> dist(0, 3);
+    std::vector<int> a(200), b(200);
+    for(size_t i=0; i<a.size(); i++){
+        a[i] = dist(generator);
+        b[i] = dist(generator);
+    }
+    std::vector<int> nearA = a;
+    nearA[7] = (nearA[7] + 1) % 4;
+
+    auto sa = archive.signature(a);
+    EXPECT_EQ(sa, archive.signature(a));
+    EXPECT_LT(BehaviorArchive::distance(sa, archive.signature(nearA)), 0.1);
+    EXPECT_GT(BehaviorArchive::distance(sa, archive.signature(b)), 0.3);
+
+    // empty archive: every neighbour is missing
+    EXPECT_FLOAT_EQ(archive.novelty(sa), 0.5);
+    archive.add(sa);
+    EXPECT_FLOAT_EQ(archive.novelty(sa), 0);
+    EXPECT_LT(archive.novelty(archive.signature(nearA)), 0.1);
+    EXPECT_THROW(archive.novelty(BehaviorArchive::Signature(1)), std::invalid_argument);
+}
+
+TEST(BehaviorArchiveTest, ReplacesOldestSignatures) {
+    BehaviorArchive archive(1, 8, 1, 2);
+    auto s0 = archive.signature({0, 0, 0, 0});
+    auto s1 = archive.signature({1, 1, 1, 1});
+    auto s2 = archive.signature({2, 2, 2, 2});
+    archive.add(s0);
+    archive.add(s1);
+    archive.add(s2); // replaces s0
+    EXPECT_EQ(archive.size(), 2);
+    EXPECT_FLOAT_EQ(archive.novelty(s1), 0);
+    EXPECT_FLOAT_EQ(archive.novelty(s2), 0);
+    EXPECT_GT(archive.novelty(s0), 0);
+    EXPECT_THROW(BehaviorArchive(1, 3), std::invalid_argument);
+    EXPECT_EQ(BehaviorArchive::quantise({0.4f, -0.1f, 2.5f}, 0.5), (std::vector<int>{0, -1, 5}));
+}
+
+TEST(BehaviorArchiveTest, NoveltyObjectiveForSelection) {
+    Population population = testdata::unitPopulation(4, 20, 2, 2, 2);
+    std::vector<std::vector<float>> X = testdata::uniformRows(8, 50);
+    population.callTraversePath(X, 10);
+
+    BehaviorArchive archive;
+    std::vector<float> first = population.noveltyObjective(archive, "decisions", 1, 3);
+    EXPECT_EQ(archive.size(), 3);
+    for(size_t i=0; i<population.individuals.size(); i++){
+        const Network& network = population.individuals[i];
+        ASSERT_EQ(network.objectives.size(), 2);
+        EXPECT_FLOAT_EQ(network.objectives[0], network.fitness);
+        EXPECT_FLOAT_EQ(network.objectives[1], first[i]);
+    }
+    // the same behaviour is less novel once it is archived
+    std::vector<float> second = population.noveltyObjective(archive, "decisions", 1, 3, true);
+    float sumFirst = 0, sumSecond = 0;
+    for(size_t i=0; i<first.size(); i++){
+        sumFirst += first[i];
+        sumSecond += second[i];
+    }
+    EXPECT_LT(sumSecond, sumFirst);
+    EXPECT_EQ(population.individuals[0].objectives.size(), 3);
+    population.paretoTournamentSelection(2, 1, 0);
+    EXPECT_THROW(population.noveltyObjective(archive, "trajectory"), std::invalid_argument);
+}
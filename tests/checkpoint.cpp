@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../include/Checkpoint.hpp"
+#include "TestData.hpp"
+
+class CheckpointTest : public ::testing::Test {
+protected:
+    std::vector<std::vector<float>> X;
+    std::vector<int> y;
+    std::vector<float> minF = {0, 0};
+    std::vector<float> maxF = {1, 1};
+    std::string path = ::testing::TempDir() + "fracnetics_checkpoint.txt";
+
+    void SetUp() override {
+        X = testdata::uniformRows(3, 60);
+        y = testdata::thresholdLabels(X, 0, 0.5);
+    }
+
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    Population makePopulation(int seed, bool fractal = false){
+        return testdata::unitPopulation(seed, 10, 2, 2, 2, fractal);
+    }
+
+    void evolve(Population& population, int generations){
+        for(int g=0; g<generations; g++){
+            population.accuracy(X, y, 10, 2);
+            population.tournamentSelection(2, 1);
+            population.crossover(0.1);
+            population.callAddDelNodes(minF, maxF);
+            population.callEdgeMutation(0.1, 0.1);
+            population.callBoundaryMutationNormal(0.1, 0.05, false);
+        }
+    }
+};
+
+TEST_F(CheckpointTest, ResumedRunMatchesUninterruptedRun) {
+    // long enough for addDelNodes to drift the node counters away from the node counts
+    Population uninterrupted = makePopulation(5);
+    evolve(uninterrupted, 40);
+
+    Population first = makePopulation(5);
+    evolve(first, 15);
+    saveCheckpoint(first, 15, path);
+
+    Population resumed = makePopulation(99); // other seed: everything comes from the checkpoint
+    EXPECT_EQ(loadCheckpoint(resumed, path), 15);
+    evolve(resumed, 25);
+
+    EXPECT_EQ(resumed.generatorState(), uninterrupted.generatorState());
+    ASSERT_EQ(resumed.individuals.size(), uninterrupted.individuals.size());
+    for(size_t i=0; i<resumed.individuals.size(); i++){
+        const Network& a = resumed.individuals[i];
+        const Network& b = uninterrupted.individuals[i];
+        EXPECT_EQ(a.jn, b.jn);
+        EXPECT_EQ(a.pn, b.pn);
+        EXPECT_EQ(a.fitness, b.fitness);
+        ASSERT_EQ(a.innerNodes.size(), b.innerNodes.size());
+        EXPECT_EQ(a.startNode.edges, b.startNode.edges);
+        for(size_t n=0; n<a.innerNodes.size(); n++){
+            EXPECT_EQ(a.innerNodes[n].edges, b.innerNodes[n].edges);
+            EXPECT_EQ(a.innerNodes[n].boundaries, b.innerNodes[n].boundaries);
+            EXPECT_EQ(a.innerNodes[n].f, b.innerNodes[n].f);
+        }
+    }
+}
+
+TEST_F(CheckpointTest, KeepsFractalParametersAndSeedHistory) {
+    Population saved = makePopulation(7, true);
+    saved.setSeedHistoryCapacity(3);
+    for(float v : {1.5f, -2.0f, 4.0f, 8.25f}){
+        saved.individuals[2].seedHistory.push(v);
+    }
+    saveCheckpoint(saved, 0, path);
+    Population restored = makePopulation(8, true);
+    loadCheckpoint(restored, path);
+    EXPECT_EQ(restored.individuals[2].seedHistory.capacity(), 3);
+    EXPECT_EQ(restored.individuals[2].seedHistory.toVector(), (std::vector<float>{-2.0f, 4.0f, 8.25f}));
+    for(size_t i=0; i<saved.individuals.size(); i++){
+        for(size_t n=0; n<saved.individuals[i].innerNodes.size(); n++){
+            const Node& a = saved.individuals[i].innerNodes[n];
+            const Node& b = restored.individuals[i].innerNodes[n];
+            EXPECT_EQ(a.k_d, b.k_d);
+            EXPECT_EQ(a.productionRuleParameter, b.productionRuleParameter);
+            EXPECT_EQ(a.boundaries, b.boundaries);
+        }
+    }
+}
+
+TEST_F(CheckpointTest, KeepsSeedPool) {
+    Population saved = makePopulation(6);
+    saved.seedPool.anchors = {11, 12};
+    saved.seedPool.rolling = {1, 2, 3};
+    saved.seedPool.maxSeed = 500;
+    saved.rollSeedPool(2);
+    saveCheckpoint(saved, 4, path);
+
+    Population restored = makePopulation(9);
+    loadCheckpoint(restored, path);
+    EXPECT_EQ(restored.seedPool.anchors, saved.seedPool.anchors);
+    EXPECT_EQ(restored.seedPool.rolling, saved.seedPool.rolling);
+    EXPECT_EQ(restored.seedPool.maxSeed, 500);
+    // the next generations draw the same seeds
+    EXPECT_EQ(restored.rollSeedPool(2), saved.rollSeedPool(2));
+}
+
+TEST_F(CheckpointTest, KeepsNonFiniteAndSubnormalValues) {
+    Population saved = makePopulation(2);
+    saved.bestFit = std::numeric_limits<float>::infinity();
+    saved.minFitness = -std::numeric_limits<float>::infinity();
+    saved.meanFitness = std::numeric_limits<float>::quiet_NaN();
+    saved.individuals[0].fitness = std::numeric_limits<float>::denorm_min();
+    saveCheckpoint(saved, 1, path);
+    Population restored = makePopulation(3);
+    loadCheckpoint(restored, path);
+    EXPECT_EQ(restored.bestFit, saved.bestFit);
+    EXPECT_EQ(restored.minFitness, saved.minFitness);
+    EXPECT_TRUE(std::isnan(restored.meanFitness));
+    EXPECT_EQ(restored.individuals[0].fitness, std::numeric_limits<float>::denorm_min());
+}
+
+TEST_F(CheckpointTest, RejectsMismatchedOrCorruptFiles) {
+    Population saved = makePopulation(1);
+    saveCheckpoint(saved, 2, path);
+
+    Population other(1, 11, 2, 2, 2, 2, false);
+    EXPECT_THROW(loadCheckpoint(other, path), std::runtime_error);
+
+    // a broken edge is caught by the genome validation before anything is written
+    std::ifstream in(path);
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    size_t individual = text.find("individual ");
+    size_t lineEnd = text.find('\n', individual);
+    std::istringstream fields(text.substr(individual, lineEnd - individual));
+    std::string keyword, fitness, nBest, nNodes, startEdge, jn, pn;
+    fields >> keyword >> fitness >> nBest >> nNodes >> startEdge >> jn >> pn;
+    text.replace(individual, lineEnd - individual,
+                 keyword + " " + fitness + " " + nBest + " " + nNodes + " 999 " + jn + " " + pn);
+    std::ofstream(path) << text;
+
+    Population target = makePopulation(4);
+    std::string before = target.generatorState();
+    EXPECT_THROW(loadCheckpoint(target, path), std::invalid_argument);
+    EXPECT_EQ(target.generatorState(), before);
+
+    EXPECT_THROW(loadCheckpoint(target, path + ".missing"), std::runtime_error);
+}
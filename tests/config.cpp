@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "../include/Config.hpp"
+
+TEST(ConfigTest, ParsesSectionsTypesAndLists) {
+    Config config = Config::fromString(
+        "# training job\n"
+        "name = demo\n"
+        "[population]\n"
+        "individuals = 500   # inline comment\n"
+        "fractalJudgment = yes\n"
+        "\n"
+        "; other comment style\n"
+        "[fitness]\n"
+        "positions = -1, 0, 1\n");
+    EXPECT_EQ(config.get<std::string>("name", ""), "demo");
+    EXPECT_EQ(config.get<int>("population.individuals", 0), 500);
+    EXPECT_TRUE(config.get<bool>("population.fractalJudgment", false));
+    EXPECT_EQ(config.get<int>("population.jn", 3), 3);
+    EXPECT_EQ(config.getList<float>("fitness.positions"), (std::vector<float>{-1, 0, 1}));
+    EXPECT_TRUE(config.getList<int>("data.features").empty());
+
+    config.set("population.individuals", "20");
+    EXPECT_EQ(config.require<int>("population.individuals"), 20);
+}
+
+TEST(ConfigTest, ReportsInvalidInput) {
+    EXPECT_THROW(Config::fromString("[population\n"), std::invalid_argument);
+    EXPECT_THROW(Config::fromString("individuals 500\n"), std::invalid_argument);
+
+    Config config = Config::fromString("[population]\nindividuals = 5x\nfractalJudgment = maybe\n");
+    EXPECT_THROW(config.get<int>("population.individuals", 0), std::invalid_argument);
+    EXPECT_THROW(config.get<bool>("population.fractalJudgment", false), std::invalid_argument);
+    EXPECT_THROW(config.require<int>("population.jn"), std::invalid_argument);
+    EXPECT_THROW(Config::fromFile("/nonexistent/train.ini"), std::runtime_error);
+}
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "../include/Population.hpp"
+#include "TestData.hpp"
+
+TEST(FoldSplitsTest, KFoldCoversEveryRowOnceAsTest) {
+    std::vector<Fold> folds = kFoldSplits(10, 3);
+    ASSERT_EQ(folds.size(), 3);
+    EXPECT_EQ(folds[0].test, (std::vector<size_t>{0, 1, 2, 3}));
+    EXPECT_EQ(folds[2].test, (std::vector<size_t>{7, 8, 9}));
+    EXPECT_EQ(folds[1].train, (std::vector<size_t>{0, 1, 2, 3, 7, 8, 9}));
+    EXPECT_THROW(kFoldSplits(10, 1), std::invalid_argument);
+}
+
+TEST(FoldSplitsTest, WalkForwardExpandingAndSliding) {
+    std::vector<Fold> expanding = walkForwardSplits(10, 2, 3);
+    EXPECT_EQ(expanding[0].train.size(), 4);
+    EXPECT_EQ(expanding[1].train.size(), 7);
+    EXPECT_EQ(expanding[1].test, (std::vector<size_t>{7, 8, 9}));
+    std::vector<Fold> sliding = walkForwardSplits(10, 2, 3, "sliding", 2);
+    EXPECT_EQ(sliding[1].train, (std::vector<size_t>{5, 6}));
+    EXPECT_THROW(walkForwardSplits(10, 2, 3, "sliding", 5), std::invalid_argument);
+    EXPECT_THROW(walkForwardSplits(6, 2, 3), std::invalid_argument);
+}
+
+TEST(CrossValidationTest, FoldScoresEqualEvaluationsOnCopiedRows) {
+    std::vector<std::vector<float>> X = testdata::uniformRows(4, 150);
+    std::vector<int> y = testdata::thresholdLabels(X, 0, 0.6);
+    std::vector<Fold> folds = kFoldSplits(X.size(), 4);
+    Population population = testdata::unitPopulation(3, 10, 3, 3, 2);
+    population.crossValidationAccuracy(X, y, folds, 10, "train", "quantile", 0.25);
+    for(auto& net : population.individuals){
+        ASSERT_EQ(net.fitnessValues.size(), folds.size());
+        for(size_t k=0; k<folds.size(); k++){
+            std::vector<std::vector<float>> Xk;
+            std::vector<int> yk;
+            for(size_t r : folds[k].train){
+                Xk.push_back(X[r]);
+                yk.push_back(y[r]);
+            }
+            Network reference = net;
+            reference.fitAccuracy(Xk, yk, 10, 0);
+            EXPECT_FLOAT_EQ(net.fitnessValues[k], reference.fitness);
+        }
+        EXPECT_FLOAT_EQ(net.fitness, aggregateScores(net.fitnessValues, "quantile", 0.25));
+    }
+    EXPECT_THROW(population.crossValidationAccuracy(X, y, folds, 10, "valid"), std::invalid_argument);
+}
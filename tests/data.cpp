@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "../include/Data.hpp"
+#include "../include/Network.hpp"
+
+class DerivedFeatureTest : public ::testing::Test {
+protected:
+    Data data;
+
+    void SetUp() override {
+        // two columns: a ramp and a zig-zag
+        for(int i=0; i<20; i++){
+            data.X.push_back({static_cast<float>(i), static_cast<float>((i % 3) - 1)});
+        }
+    }
+};
+
+TEST_F(DerivedFeatureTest, FeatureIndicesFollowBaseColumns) {
+    EXPECT_EQ(data.addLagFeature(0, 2), 2);
+    EXPECT_EQ(data.addRatioFeature(1, 0), 3);
+    EXPECT_EQ(data.nFeatures(), 4);
+    EXPECT_THROW(data.addLagFeature(5, 1), std::invalid_argument);
+    EXPECT_THROW(data.addRollingMeanFeature(0, 0), std::invalid_argument);
+}
+
+TEST_F(DerivedFeatureTest, CursorMatchesMaterializedColumns) {
+    int lag = data.addLagFeature(0, 3);
+    int diff = data.addDiffFeature(1, 2);
+    int mean = data.addRollingMeanFeature(0, 4);
+    int stdev = data.addRollingStdFeature(1, 5);
+    int ratio = data.addRatioFeature(1, 0);
+
+    Data::FeatureCursor cursor(data);
+    for(size_t r=0; r<data.X.size(); r++){
+        cursor.seek(r);
+        // lag and diff are padded with the first row
+        size_t lagRow = r >= 3 ? r - 3 : 0;
+        size_t diffRow = r >= 2 ? r - 2 : 0;
+        EXPECT_FLOAT_EQ(cursor[lag], data.X[lagRow][0]);
+        EXPECT_FLOAT_EQ(cursor[diff], data.X[r][1] - data.X[diffRow][1]);
+
+        // rolling windows shrink at the start
+        double sum = 0;
+        size_t start = r + 1 >= 4 ? r + 1 - 4 : 0;
+        for(size_t k=start; k<=r; k++){ sum += data.X[k][0]; }
+        EXPECT_NEAR(cursor[mean], sum / (r - start + 1), 1e-5);
+
+        start = r + 1 >= 5 ? r + 1 - 5 : 0;
+        double s = 0, sq = 0;
+        for(size_t k=start; k<=r; k++){ s += data.X[k][1]; sq += data.X[k][1] * data.X[k][1]; }
+        double n = r - start + 1;
+        EXPECT_NEAR(cursor[stdev], std::sqrt(std::max(0.0, sq / n - (s / n) * (s / n))), 1e-5);
+
+        float expectedRatio = data.X[r][0] == 0 ? 0.0f : data.X[r][1] / data.X[r][0];
+        EXPECT_FLOAT_EQ(cursor[ratio], expectedRatio);
+
+        // random access gives the same values as sequential access
+        EXPECT_FLOAT_EQ(data.derivedValue(r, data.derivedFeatures[stdev - 2]), cursor[stdev]);
+    }
+}
+
+TEST_F(DerivedFeatureTest, MinMaxIncludesDerivedFeatures) {
+    data.addDiffFeature(0, 1);
+    data.minMaxFeatures(data.X);
+    data.minMaxDerivedFeatures();
+    ASSERT_EQ(data.minX.size(), 3);
+    EXPECT_FLOAT_EQ(data.minX[2], 0.0f); // first row is padded
+    EXPECT_FLOAT_EQ(data.maxX[2], 1.0f);
+    // repeated calls keep the bounds aligned with the feature indices
+    data.minMaxDerivedFeatures();
+    ASSERT_EQ(data.minX.size(), 3);
+    EXPECT_FLOAT_EQ(data.maxX[2], 1.0f);
+}
+
+TEST_F(DerivedFeatureTest, AccuracyOnDerivedFeaturesEqualsMaterializedData) {
+    data.addLagFeature(0, 2);
+    data.addRollingMeanFeature(1, 3);
+    data.minMaxFeatures(data.X);
+    data.minMaxDerivedFeatures();
+
+    // materialise the derived columns as reference
+    std::vector<std::vector<float>> materialized;
+    Data::FeatureCursor cursor(data);
+    std::vector<int> y;
+    for(size_t r=0; r<data.X.size(); r++){
+        cursor.seek(r);
+        materialized.push_back({cursor[0], cursor[1], cursor[2], cursor[3]});
+        y.push_back(r % 2);
+    }
+
+    auto generator = std::make_shared<std::mt19937_64>(7);
+    for(int n=0; n<10; n++){
+        Network net(generator, 4, data.nFeatures(), 3, 2, false);
+        for(auto& node : net.innerNodes){
+            if(node.type == "J"){
+                node.setEdgesBoundaries(data.minX[node.f], data.maxX[node.f]);
+            }
+        }
+        Network reference = net;
+        net.fitAccuracy(data, y, 10, 1);
+        reference.fitAccuracy(materialized, y, 10, 1);
+        EXPECT_FLOAT_EQ(net.fitness, reference.fitness);
+        EXPECT_EQ(net.invalid, reference.invalid);
+    }
+}
+
+TEST(ReadBinaryTest, ChecksShapeAgainstFileSize) {
+    std::string path = ::testing::TempDir() + "fracnetics_data.bin";
+    auto write = [&](uint64_t rows, uint64_t cols, const std::vector<float>& values){
+        std::ofstream out(path, std::ios::binary);
+        uint64_t shape[2] = {rows, cols};
+        out.write(reinterpret_cast<const char*>(shape), sizeof(shape));
+        out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+    };
+
+    write(2, 3, {1, 2, 3, 4, 5, 6});
+    Data data;
+    data.readBinary(path);
+    EXPECT_EQ(data.dt, (std::vector<std::vector<float>>{{1, 2, 3}, {4, 5, 6}}));
+
+    // a corrupt header fails before rows are allocated
+    write(uint64_t(1) << 60, 3, {1, 2, 3});
+    Data huge;
+    EXPECT_THROW(huge.readBinary(path), std::runtime_error);
+    EXPECT_TRUE(huge.dt.empty());
+    write(3, 3, {1, 2, 3, 4, 5, 6});
+    EXPECT_THROW(huge.readBinary(path), std::runtime_error);
+    write(uint64_t(1) << 40, 0, {});
+    EXPECT_THROW(huge.readBinary(path), std::runtime_error);
+    std::remove(path.c_str());
+}
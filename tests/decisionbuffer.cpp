@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "../include/Population.hpp"
+#include "TestData.hpp"
+
+TEST(DecisionBufferTest, WidthFollowsPnf) {
+    EXPECT_EQ(DecisionBuffer::bitsFor(2), 1);
+    EXPECT_EQ(DecisionBuffer::bitsFor(3), 2);
+    EXPECT_EQ(DecisionBuffer::bitsFor(4), 2);
+    EXPECT_EQ(DecisionBuffer::bitsFor(5), 4);
+    EXPECT_EQ(DecisionBuffer::bitsFor(16), 4);
+    EXPECT_EQ(DecisionBuffer::bitsFor(17), 8);
+    EXPECT_EQ(DecisionBuffer::bitsFor(256), 8);
+    EXPECT_EQ(DecisionBuffer::bitsFor(257), 16);
+}
+
+TEST(DecisionBufferTest, PackedValuesAndInvalidRowsRoundTrip) {
+    for(unsigned int pnf : {2u, 3u, 11u, 200u, 1000u}){
+        DecisionBuffer buffer(pnf);
+        std::vector<int> expected;
+        for(int i=0; i<300; i++){
+            if(i % 37 == 5){
+                buffer.pushInvalid();
+                expected.push_back(-1);
+            } else {
+                buffer.push_back(i % pnf);
+                expected.push_back(i % pnf);
+            }
+        }
+        EXPECT_EQ(buffer.toVector(), expected);
+        EXPECT_TRUE(buffer.isInvalid(5));
+        EXPECT_FALSE(buffer.isInvalid(6));
+        EXPECT_EQ(buffer.bytes(), (300 * buffer.bitsPerDecision() + 63) / 64 * 8);
+    }
+}
+
+TEST(DecisionBufferTest, CompactTraversalEqualsTraversePath) {
+    std::vector<std::vector<float>> X = testdata::uniformRows(12, 100);
+    Population population = testdata::unitPopulation(3, 10, 4, 3, 2);
+    Population reference = population;
+    population.callTraversePath(X, 3, true);
+    reference.callTraversePath(X, 3);
+    for(size_t i=0; i<population.individuals.size(); i++){
+        const DecisionBuffer& packed = population.individuals[i].compactDecisions;
+        const std::vector<int>& decisions = reference.individuals[i].decisions;
+        ASSERT_EQ(packed.size(), decisions.size());
+        EXPECT_EQ(packed.bitsPerDecision(), 1);
+        EXPECT_TRUE(population.individuals[i].decisions.empty());
+        for(size_t r=0; r<decisions.size(); r++){
+            if(decisions[r] == std::numeric_limits<int>::lowest()){
+                EXPECT_TRUE(packed.isInvalid(r));
+            } else {
+                EXPECT_FALSE(packed.isInvalid(r));
+                EXPECT_EQ(packed[r], decisions[r]);
+            }
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "../include/Population.hpp"
+
+class DecisionCacheTest : public ::testing::Test {
+protected:
+    std::vector<std::vector<float>> X;
+    std::vector<float> minF = {0, 0, 0};
+    std::vector<float> maxF = {1, 1, 1};
+
+    void SetUp() override {
+        // a discretised sensor: few distinct values, some of them on the boundaries
+        std::mt19937_64 generator(17);
+        std::uniform_int_distribution<int> level(0, 8);
+        for(int i=0; i<500; i++){
+            X.push_back({level(generator) / 8.0f, level(generator) / 8.0f, level(generator) / 8.0f});
+        }
+    }
+};
+
+TEST_F(DecisionCacheTest, CachedTraversalIsExact) {
+    Population population(21, 10, 4, 3, 3, 3, false);
+    population.setAllNodeBoundaries(minF, maxF);
+    for(const Network& original : population.individuals){
+        Network plain = original;
+        Network cached = original;
+        cached.setDecisionCache(256);
+        plain.initPathTraversal();
+        cached.initPathTraversal();
+        for(const auto& row : X){
+            int expected = plain.decisionAndNextNode(row, 6);
+            int dec = cached.decisionAndNextNode(row, 6);
+            ASSERT_EQ(dec, expected);
+            ASSERT_EQ(cached.currentNodeID, plain.currentNodeID);
+            ASSERT_EQ(cached.nConsecutiveP, plain.nConsecutiveP);
+            ASSERT_EQ(cached.invalid, plain.invalid);
+            ASSERT_EQ(cached.traverseCounter, plain.traverseCounter);
+            if(plain.invalid){
+                break;
+            }
+        }
+    }
+}
+
+TEST_F(DecisionCacheTest, ReportsHitsAndRebuildsAfterGenomeChange) {
+    auto generator = std::make_shared<std::mt19937_64>(4);
+    Network net(generator, 3, 3, 2, 2, false);
+    for(auto& node : net.innerNodes){
+        if(node.type == "J"){
+            node.setEdgesBoundaries(minF[node.f], maxF[node.f]);
+        }
+    }
+    EXPECT_FALSE(net.decisionCache.enabled());
+    net.setDecisionCache(1024);
+    net.traversePath(X, 10);
+    std::vector<int> first = net.decisions;
+    const DecisionCacheStats& stats = net.decisionCache.stats();
+    EXPECT_EQ(stats.rebuilds, 1);
+    EXPECT_GT(stats.hits, 0);
+    // the second pass repeats all observations from the same states
+    net.traversePath(X, 10);
+    EXPECT_EQ(net.decisions, first);
+    EXPECT_GT(stats.hitRate(), 0.5);
+    EXPECT_EQ(stats.bypassed, 0);
+
+    // boundaries moved: the cache is rebuilt and stays exact
+    for(auto& node : net.innerNodes){
+        if(node.type == "J"){
+            node.setEdgesBoundaries(0.2f, 0.7f);
+        }
+    }
+    net.genomeChanged();
+    net.traversePath(X, 10);
+    EXPECT_EQ(net.decisionCache.stats().rebuilds, 2);
+    Network plain = net;
+    plain.setDecisionCache(0);
+    plain.traversePath(X, 10);
+    EXPECT_EQ(net.decisions, plain.decisions);
+
+    net.decisionCache.resetStats();
+    EXPECT_FLOAT_EQ(net.decisionCache.stats().hitRate(), 0);
+}
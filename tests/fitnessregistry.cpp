@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "../include/Population.hpp"
+#include "TestData.hpp"
+
+namespace {
+
+struct LabelAccuracy {
+    const float* labels;
+    size_t nRows;
+    float correct = 0;
+
+    LabelAccuracy(const float* targets, size_t rows, size_t):
+        labels(targets),
+        nRows(rows)
+    {}
+
+    void consume(size_t row, int32_t decision){
+        if(decision == static_cast<int32_t>(labels[row])){
+            correct += 1;
+        }
+    }
+
+    float finish(){
+        return nRows == 0 ? 0 : correct / nRows;
+    }
+};
+
+struct ThrowingKernel {
+    static inline int alive = 0;
+
+    ThrowingKernel(const float*, size_t, size_t){
+        alive++;
+    }
+    ~ThrowingKernel(){
+        alive--;
+    }
+
+    void consume(size_t row, int32_t){
+        if(row == 3){
+            throw std::runtime_error("kernel failure");
+        }
+    }
+
+    float finish(){
+        return 1;
+    }
+};
+
+struct ConstantKernel {
+    ConstantKernel(const float*, size_t, size_t){}
+    void consume(size_t, int32_t){}
+    float finish(){
+        return 7;
+    }
+};
+
+}
+
+TEST(FitnessRegistryTest, RegisteredKernelEqualsBuiltInAccuracy) {
+    registerFitnessKernel<LabelAccuracy>("labelAccuracy");
+    std::vector<std::vector<float>> X = testdata::uniformRows(9, 120);
+    std::vector<int> y = testdata::thresholdLabels(X, 1, 0.5);
+    std::vector<float> targets(y.begin(), y.end());
+    Population population = testdata::unitPopulation(1, 10, 3, 3, 2);
+    Population reference = population;
+
+    population.nativeFitness("labelAccuracy", X, targets, 1, 10, 0);
+    reference.accuracy(X, y, 10, 0);
+    for(size_t i=0; i<population.individuals.size(); i++){
+        EXPECT_FLOAT_EQ(population.individuals[i].fitness, reference.individuals[i].fitness);
+    }
+    EXPECT_THROW(population.nativeFitness("labelAccuracy", X, targets, 2, 10, 0), std::invalid_argument);
+}
+
+TEST(FitnessRegistryTest, RejectsUnknownKernelsAndPlugins) {
+    Population population(1, 2, 3, 2, 3, 2, false);
+    EXPECT_THROW(population.nativeFitness("noSuchKernel", {}, {}, 0, 10, 0), std::invalid_argument);
+    EXPECT_THROW(loadFitnessPlugin("/nonexistent/plugin.so"), std::runtime_error);
+
+    FracneticsFitnessKernel kernel = makeFitnessKernel<LabelAccuracy>("oldAbi");
+    kernel.abiVersion = FRACNETICS_FITNESS_ABI_VERSION + 1;
+    EXPECT_THROW(FitnessRegistry::instance().add(kernel), std::invalid_argument);
+}
+
+TEST(FitnessRegistryTest, LookedUpKernelSurvivesReregistration) {
+    registerFitnessKernel<LabelAccuracy>("replacedKernel");
+    std::shared_ptr<const FracneticsFitnessKernel> held = FitnessRegistry::instance().find("replacedKernel");
+    registerFitnessKernel<ConstantKernel>("replacedKernel");
+    EXPECT_STREQ(held->name, "replacedKernel");
+    float label = 1;
+    void* state = held->create(held->userData, &label, 1, 1);
+    held->consume(state, 0, 1);
+    EXPECT_FLOAT_EQ(held->finish(state), 1); // still the old kernel
+    held->destroy(state);
+
+    std::shared_ptr<const FracneticsFitnessKernel> current = FitnessRegistry::instance().find("replacedKernel");
+    state = current->create(current->userData, nullptr, 0, 0);
+    EXPECT_FLOAT_EQ(current->finish(state), 7);
+    current->destroy(state);
+}
+
+TEST(FitnessRegistryTest, NativeFitnessReleasesStateOnException) {
+    FracneticsFitnessKernel kernel = makeFitnessKernel<ThrowingKernel>("throwing");
+    auto generator = std::make_shared<std::mt19937_64>(2);
+    Network net(generator, 2, 2, 2, 2, false);
+    for(auto& node : net.innerNodes){
+        if(node.type == "J"){
+            node.setEdgesBoundaries(0, 1);
+        }
+    }
+    std::vector<std::vector<float>> X(10, std::vector<float>{0.5f, 0.5f});
+    EXPECT_THROW(net.fitNative(X, kernel, nullptr, 0, 100, 0), std::runtime_error);
+    EXPECT_EQ(ThrowingKernel::alive, 0);
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "../include/Population.hpp"
+#include "TestData.hpp"
+
+class GenomeBudgetTest : public ::testing::Test {
+protected:
+    std::vector<std::vector<float>> X;
+    std::vector<int> y;
+    std::vector<float> minF = {0, 0};
+    std::vector<float> maxF = {1, 1};
+
+    void SetUp() override {
+        X = testdata::uniformRows(5, 60);
+        y = testdata::labels(X, [](const std::vector<float>& row){ return row[0] > row[1]; });
+    }
+};
+
+TEST_F(GenomeBudgetTest, PruneUnreachableKeepsDecisions) {
+    auto generator = std::make_shared<std::mt19937_64>(9);
+    Network net(generator, 4, 2, 4, 2, false);
+    for(auto& node : net.innerNodes){
+        if(node.type == "J"){
+            node.setEdgesBoundaries(minF[node.f], maxF[node.f]);
+        }
+    }
+    // append a node that nothing points to
+    Node orphan = net.innerNodes[0];
+    orphan.id = net.innerNodes.size();
+    net.innerNodes.push_back(orphan);
+    net.traversePath(X, 10);
+    std::vector<int> before = net.decisions;
+
+    size_t nodes = net.innerNodes.size();
+    size_t removed = net.pruneUnreachable();
+    EXPECT_GE(removed, 1);
+    EXPECT_EQ(net.innerNodes.size(), nodes - removed);
+    for(size_t i=0; i<net.innerNodes.size(); i++){
+        EXPECT_EQ(net.innerNodes[i].id, i);
+        for(int e : net.innerNodes[i].edges){
+            EXPECT_LT(e, net.innerNodes.size());
+        }
+    }
+    net.traversePath(X, 10);
+    EXPECT_EQ(net.decisions, before);
+    EXPECT_EQ(net.pruneUnreachable(), 0);
+
+    // pruning unused nodes keeps the decisions of the last traversal as well
+    net.pruneUnused(net.innerNodes.size());
+    EXPECT_GE(net.innerNodes.size(), 3);
+    net.traversePath(X, 10);
+    EXPECT_EQ(net.decisions, before);
+}
+
+TEST_F(GenomeBudgetTest, GenomeBytesAreCached) {
+    auto generator = std::make_shared<std::mt19937_64>(2);
+    Network net(generator, 3, 2, 3, 2, false);
+    size_t bytes = net.genomeBytes();
+    EXPECT_GT(bytes, net.innerNodes.size() * sizeof(Node));
+    EXPECT_FALSE(net.genomeBytesDirty);
+    net.innerNodes.push_back(net.innerNodes[0]);
+    EXPECT_EQ(net.genomeBytes(), bytes); // stale until genomeChanged()
+    net.genomeChanged();
+    EXPECT_GT(net.genomeBytes(), bytes);
+}
+
+TEST_F(GenomeBudgetTest, BudgetBoundsGrowth) {
+    Population population = testdata::unitPopulation(3, 20, 2, 2, 2);
+    MemoryUsage initial = population.memoryUsage();
+    EXPECT_EQ(initial.nodes, 20 * 4);
+    EXPECT_EQ(population.enforceBudget(), 0); // inactive
+
+    population.budget.maxNodes = initial.nodes + 2;
+    for(int g=0; g<30; g++){
+        population.accuracy(X, y, 10, 2);
+        population.tournamentSelection(2, 2);
+        population.crossover(0.1, "randomWidth");
+        population.callAddDelNodes(minF, maxF);
+        population.callEdgeMutation(0.1, 0.1);
+        EXPECT_LE(population.memoryUsage().nodes, population.budget.maxNodes);
+    }
+    EXPECT_GT(population.budgetStats.rejectedGrowth + population.budgetStats.prunedUnreachable +
+              population.budgetStats.prunedUnused, 0);
+
+    // a byte budget below the current usage is enforced by pruning non-elite individuals
+    population.accuracy(X, y, 10, 2);
+    population.budget.maxNodes = 0;
+    population.budget.maxBytes = population.memoryUsage().bytes - 1;
+    population.enforceBudget();
+    EXPECT_LE(population.memoryUsage().bytes, population.budget.maxBytes);
+}
+
+TEST_F(GenomeBudgetTest, SelectionPrefersSmallerAtEqualFitness) {
+    Population population(4, 6, 2, 2, 2, 2, false);
+    for(auto& network : population.individuals){
+        network.fitness = 1;
+    }
+    auto& small = population.individuals[3].innerNodes;
+    small.erase(small.begin() + 3, small.end());
+    population.budget.maxNodes = 1000;
+    population.tournamentSelection(6, 1);
+    ASSERT_EQ(population.indicesElite.size(), 1);
+    EXPECT_EQ(population.individuals[population.indicesElite[0]].innerNodes.size(), 3);
+}
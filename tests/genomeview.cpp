@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+#include "../include/GenomeView.hpp"
+#include "TestData.hpp"
+
+class GenomeViewTest : public ::testing::Test {
+protected:
+    std::shared_ptr<std::mt19937_64> generator = std::make_shared<std::mt19937_64>(8);
+    std::vector<std::vector<float>> X;
+
+    void SetUp() override {
+        X = testdata::uniformRows(*generator, 50);
+    }
+
+    Network makeNetwork(){
+        Network net(generator, 4, 2, 3, 2, false);
+        for(auto& node : net.innerNodes){
+            if(node.type == "J"){
+                node.setEdgesBoundaries(0, 1);
+            }
+        }
+        return net;
+    }
+};
+
+TEST_F(GenomeViewTest, RoundTripKeepsDecisions) {
+    Network net = makeNetwork();
+    GenomeView view = GenomeView::fromNetwork(net);
+    ASSERT_EQ(view.size(), net.innerNodes.size());
+    ASSERT_EQ(view.edgeOffsets.back(), view.edgeTargets.size());
+    for(size_t i=0; i<view.size(); i++){
+        EXPECT_EQ(view.edgeOffsets[i+1] - view.edgeOffsets[i], net.innerNodes[i].edges.size());
+    }
+    Network copy = net;
+    view.applyTo(copy);
+    net.traversePath(X, 10);
+    copy.traversePath(X, 10);
+    EXPECT_EQ(net.decisions, copy.decisions);
+}
+
+TEST_F(GenomeViewTest, AppliesEditedEdges) {
+    Network net = makeNetwork();
+    GenomeView view = GenomeView::fromNetwork(net);
+    size_t p = 4; // first processing node
+    int32_t target = (view.edgeTargets[view.edgeOffsets[p]] + 1) % view.size();
+    if(target == static_cast<int32_t>(p)){
+        target = (target + 1) % view.size();
+    }
+    view.edgeTargets[view.edgeOffsets[p]] = target;
+    net.streamState.valid = true;
+    view.applyTo(net);
+    EXPECT_EQ(net.innerNodes[p].edges[0], target);
+    EXPECT_FALSE(net.streamState.valid);
+}
+
+TEST_F(GenomeViewTest, RejectsInvalidGenomeWithoutModifyingNetwork) {
+    Network net = makeNetwork();
+    GenomeView original = GenomeView::fromNetwork(net);
+
+    GenomeView selfLoop = original;
+    selfLoop.edgeTargets[selfLoop.edgeOffsets[5]] = 5;
+    EXPECT_THROW(selfLoop.applyTo(net), std::invalid_argument);
+
+    GenomeView unsorted = original;
+    std::swap(unsorted.boundaryValues[0], unsorted.boundaryValues[1]);
+    EXPECT_THROW(unsorted.applyTo(net), std::invalid_argument);
+
+    GenomeView badFunction = original;
+    badFunction.functions[0] = 7;
+    EXPECT_THROW(badFunction.applyTo(net), std::invalid_argument);
+
+    GenomeView badOffsets = original;
+    badOffsets.edgeOffsets.back() += 1;
+    EXPECT_THROW(badOffsets.applyTo(net), std::invalid_argument);
+
+    GenomeView after = GenomeView::fromNetwork(net);
+    EXPECT_EQ(after.edgeTargets, original.edgeTargets);
+    EXPECT_EQ(after.boundaryValues, original.boundaryValues);
+}
+
+TEST_F(GenomeViewTest, RejectsJudgmentNodesWithoutBoundaries) {
+    Network net = makeNetwork();
+    GenomeView original = GenomeView::fromNetwork(net);
+
+    // one judgment node without boundaries while the others have them
+    GenomeView mixed = original;
+    int64_t removed = mixed.boundaryOffsets[1] - mixed.boundaryOffsets[0];
+    mixed.boundaryValues.erase(mixed.boundaryValues.begin(), mixed.boundaryValues.begin() + removed);
+    for(auto& offset : mixed.boundaryOffsets){
+        offset = std::max<int64_t>(0, offset - removed);
+    }
+    EXPECT_THROW(mixed.validate(net.jnf, net.pnf), std::invalid_argument);
+    EXPECT_THROW(mixed.applyTo(net), std::invalid_argument);
+
+    // a genome without any boundaries is valid, but not for a network whose boundaries are set
+    GenomeView unset = original;
+    unset.boundaryValues.clear();
+    std::fill(unset.boundaryOffsets.begin(), unset.boundaryOffsets.end(), 0);
+    EXPECT_NO_THROW(unset.validate(net.jnf, net.pnf));
+    EXPECT_THROW(unset.applyTo(net), std::invalid_argument);
+    Network fresh(generator, 4, 2, 3, 2, false);
+    EXPECT_NO_THROW(unset.applyTo(fresh));
+
+    GenomeView after = GenomeView::fromNetwork(net);
+    EXPECT_EQ(after.boundaryValues, original.boundaryValues);
+}
+
+TEST_F(GenomeViewTest, ResetsFractalParametersOfReshapedNodes) {
+    Network net(generator, 4, 2, 3, 2, true);
+    for(auto& node : net.innerNodes){
+        if(node.type == "J"){
+            node.productionRuleParameter = randomParameterCuts(node.k_d.first-1, generator);
+            node.setEdgesBoundaries(0, 1, fractalLengths(node.k_d.second, sortAndDistance(node.productionRuleParameter)));
+        }
+    }
+    net.pnRatio(); // accumulates into the node counters
+    GenomeView view = GenomeView::fromNetwork(net);
+    // node 0 becomes a judgment node with two edges, node 4 a judgment node with one edge
+    GenomeView edited;
+    edited.startEdge = view.startEdge;
+    edited.edgeOffsets = {0};
+    edited.boundaryOffsets = {0};
+    for(size_t i=0; i<view.size(); i++){
+        std::vector<int32_t> edges(view.edgeTargets.begin()+view.edgeOffsets[i], view.edgeTargets.begin()+view.edgeOffsets[i+1]);
+        std::vector<double> boundaries(view.boundaryValues.begin()+view.boundaryOffsets[i], view.boundaryValues.begin()+view.boundaryOffsets[i+1]);
+        uint8_t type = view.types[i];
+        if(i == 0){
+            edges = {1, 2};
+            boundaries = {0, 0.3, 1};
+        } else if(i == 4){
+            type = 'J';
+            boundaries = {0, 1};
+        }
+        edited.types.push_back(type);
+        edited.functions.push_back(type == 'J' ? std::min(view.functions[i], 1) : view.functions[i]);
+        edited.edgeTargets.insert(edited.edgeTargets.end(), edges.begin(), edges.end());
+        edited.boundaryValues.insert(edited.boundaryValues.end(), boundaries.begin(), boundaries.end());
+        edited.edgeOffsets.push_back(edited.edgeTargets.size());
+        edited.boundaryOffsets.push_back(edited.boundaryValues.size());
+    }
+    std::vector<float> kept = net.innerNodes[1].productionRuleParameter;
+    edited.applyTo(net);
+
+    EXPECT_TRUE(net.innerNodes[0].productionRuleParameter.empty());
+    EXPECT_EQ(net.innerNodes[0].k_d, std::make_pair(0, 0));
+    EXPECT_TRUE(net.innerNodes[4].productionRuleParameter.empty());
+    EXPECT_EQ(net.innerNodes[1].productionRuleParameter, kept); // unchanged node
+    EXPECT_EQ(net.jn, 5);
+    EXPECT_EQ(net.pn, 2);
+
+    // reshaped nodes keep their boundaries under fractal mutation
+    std::vector<float> minF = {0, 0};
+    std::vector<float> maxF = {1, 1};
+    net.innerNodes[0].boundaryMutationFractal(1, minF, maxF);
+    EXPECT_EQ(net.innerNodes[0].boundaries, (std::vector<double>{0, 0.3, 1}));
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "../include/Population.hpp"
+#include "TestData.hpp"
+
+TEST(ConfusionAccumulatorTest, MetricsOfKnownConfusionMatrix) {
+    // true 0: 6x predicted 0, 2x predicted 1; true 1: 1x predicted 0, 1x predicted 1
+    ConfusionAccumulator counts(2);
+    for(int i=0; i<6; i++) counts.update(0, 0);
+    for(int i=0; i<2; i++) counts.update(0, 1);
+    counts.update(1, 0);
+    counts.update(1, 1);
+    EXPECT_NEAR(counts.accuracy(), 0.7, 1e-9);
+    EXPECT_NEAR(counts.balancedAccuracy(), (0.75 + 0.5) / 2, 1e-9);
+    EXPECT_NEAR(counts.macroF1(), (12.0 / 15 + 2.0 / 5) / 2, 1e-9);
+    // p_o = 0.7, p_e = (8*7 + 2*3) / 100 = 0.62
+    EXPECT_NEAR(counts.kappa(), (0.7 - 0.62) / 0.38, 1e-9);
+    EXPECT_THROW(ConfusionAccumulator::checkMetric("f1"), std::invalid_argument);
+}
+
+TEST(ConfusionAccumulatorTest, DecisionsWithoutClassCountAsWrong) {
+    ConfusionAccumulator counts(2);
+    counts.update(0, 0);
+    counts.update(1, 5);
+    EXPECT_NEAR(counts.accuracy(), 0.5, 1e-9);
+    EXPECT_NEAR(counts.balancedAccuracy(), 0.5, 1e-9);
+    EXPECT_EQ(counts.count(1, 1), 0);
+}
+
+TEST(ClassificationMetricTest, AccuracyMetricEqualsFitAccuracyAndConfusionIsComplete) {
+    std::vector<std::vector<float>> X = testdata::uniformRows(6, 200);
+    std::vector<int> y = testdata::thresholdLabels(X, 0, 0.8); // imbalanced
+    Population population = testdata::unitPopulation(5, 10, 3, 3, 2);
+    Population reference = population;
+    std::vector<uint32_t> confusion;
+    size_t nClasses = population.classificationMetric(X, y, 10, "accuracy", &confusion);
+    reference.accuracy(X, y, 10, 0);
+    ASSERT_EQ(nClasses, 2);
+    ASSERT_EQ(confusion.size(), population.individuals.size() * 4);
+    for(size_t i=0; i<population.individuals.size(); i++){
+        EXPECT_FLOAT_EQ(population.individuals[i].fitness, reference.individuals[i].fitness);
+        if(!population.individuals[i].invalid){
+            uint32_t total = confusion[i*4] + confusion[i*4+1] + confusion[i*4+2] + confusion[i*4+3];
+            EXPECT_EQ(total, X.size()); // pnf = 2: every decision is a class
+        }
+    }
+    population.classificationMetric(X, y, 10, "kappa");
+    EXPECT_THROW(population.classificationMetric(X, y, 10, "f1"), std::invalid_argument);
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+#include "../include/Population.hpp"
+
+TEST(MinHashTest, EstimatesJaccardSimilarity) {
+    std::vector<uint64_t> a, b;
+    for(uint64_t i=0; i<400; i++){
+        a.push_back(i);
+        b.push_back(i < 300 ? i : 1000 + i); // Jaccard = 300 / 500
+    }
+    MinHashSketch sa, sb;
+    sa.build(a, 256);
+    sb.build(b, 256);
+    EXPECT_FALSE(sa.dirty);
+    EXPECT_NEAR(MinHashSketch::similarity(sa, sb), 0.6, 0.1);
+    EXPECT_FLOAT_EQ(MinHashSketch::similarity(sa, sa), 1);
+    // sparse sets are densified: no bin keeps the empty marker
+    MinHashSketch small;
+    small.build({1, 2}, 64);
+    for(uint64_t v : small.values){
+        EXPECT_NE(v, std::numeric_limits<uint64_t>::max());
+    }
+    EXPECT_THROW(small.build({1}, 0), std::invalid_argument);
+}
+
+TEST(MinHashTest, SketchIgnoresNodePositions) {
+    auto generator = std::make_shared<std::mt19937_64>(3);
+    Network net(generator, 3, 2, 3, 2, false);
+    Network permuted = net;
+    // swap two inner nodes and remap all edges: same graph, other positions
+    std::vector<int> map(net.innerNodes.size());
+    std::iota(map.begin(), map.end(), 0);
+    std::swap(map[0], map[net.innerNodes.size()-1]);
+    std::swap(permuted.innerNodes[0], permuted.innerNodes[net.innerNodes.size()-1]);
+    for(auto& node : permuted.innerNodes){
+        for(int& e : node.edges){
+            e = map[e];
+        }
+    }
+    permuted.startNode.edges[0] = map[net.startNode.edges[0]];
+    permuted.genomeChanged();
+    EXPECT_EQ(net.minHash(32).values, permuted.minHash(32).values);
+
+    // the sketch is cached until the genome changes
+    const MinHashSketch* cached = &net.minHash(32);
+    EXPECT_FALSE(net.sketch.dirty);
+    net.genomeChanged();
+    EXPECT_TRUE(net.sketch.dirty);
+    EXPECT_EQ(&net.minHash(32), cached);
+}
+
+TEST(MinHashTest, PopulationDiversity) {
+    Population population(7, 30, 3, 2, 3, 2, false);
+    DiversityStats initial = population.diversity(64, 16);
+    EXPECT_EQ(initial.recomputed, 30);
+    EXPECT_GT(initial.diversity, 0.5);
+    EXPECT_GT(initial.clusters, 1);
+    EXPECT_EQ(population.diversity(64, 16).recomputed, 0); // nothing changed
+
+    // a population of clones has no diversity
+    for(auto& network : population.individuals){
+        network = population.individuals[0];
+    }
+    DiversityStats clones = population.diversity(64, 16);
+    EXPECT_FLOAT_EQ(clones.meanSimilarity, 1);
+    EXPECT_FLOAT_EQ(clones.diversity, 0);
+    EXPECT_EQ(clones.clusters, 1);
+    EXPECT_FLOAT_EQ(clones.duplicateRatio, 29.0f / 30);
+
+    population.indicesElite = {0};
+    population.callEdgeMutation(0.5, 0.5);
+    DiversityStats mutated = population.diversity(64, 16);
+    EXPECT_EQ(mutated.recomputed, 29);
+    EXPECT_GT(mutated.diversity, 0);
+    EXPECT_THROW(population.diversity(64, 7), std::invalid_argument);
+}
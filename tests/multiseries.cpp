@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <vector>
+#include "../include/Population.hpp"
+#include "TestData.hpp"
+
+TEST(AggregationTest, MeanWorstAndQuantile) {
+    std::vector<float> scores = {0.4, 0.1, 0.3, 0.2};
+    EXPECT_NEAR(aggregateScores(scores, "mean"), 0.25, 1e-6);
+    EXPECT_FLOAT_EQ(aggregateScores(scores, "worst"), 0.1);
+    EXPECT_NEAR(aggregateScores(scores, "quantile", 0.5), 0.25, 1e-6);
+    EXPECT_FLOAT_EQ(aggregateScores(scores, "quantile", 0), 0.1);
+    EXPECT_FLOAT_EQ(aggregateScores(scores, "quantile", 1), 0.4);
+    EXPECT_THROW(checkAggregation("median"), std::invalid_argument);
+    EXPECT_THROW(checkAggregation("quantile", 1.5), std::invalid_argument);
+}
+
+TEST(AggregationTest, SeriesOffsetsAreValidated) {
+    EXPECT_NO_THROW(checkSeriesOffsets({0, 3, 3, 10}, 10));
+    EXPECT_THROW(checkSeriesOffsets({0, 5, 4, 10}, 10), std::invalid_argument);
+    EXPECT_THROW(checkSeriesOffsets({0, 5}, 10), std::invalid_argument);
+    EXPECT_THROW(checkSeriesOffsets({0}, 0), std::invalid_argument);
+}
+
+class MultiSeriesTest : public ::testing::Test {
+protected:
+    std::vector<std::vector<float>> X;
+    std::vector<int> y;
+    std::vector<size_t> offsets = {0, 80, 130, 250};
+
+    void SetUp() override {
+        X = testdata::uniformRows(11, offsets.back());
+        y = testdata::thresholdLabels(X, 1, 0.4);
+    }
+
+    std::vector<std::vector<float>> rows(size_t s){
+        return std::vector<std::vector<float>>(X.begin()+offsets[s], X.begin()+offsets[s+1]);
+    }
+
+    std::vector<int> labels(size_t s){
+        return std::vector<int>(y.begin()+offsets[s], y.begin()+offsets[s+1]);
+    }
+};
+
+TEST_F(MultiSeriesTest, SeriesScoresEqualSeparateEvaluations) {
+    Population population = testdata::unitPopulation(2, 10, 3, 3, 2);
+    population.multiSeriesAccuracy(X, y, offsets, 10, "worst");
+    for(auto& net : population.individuals){
+        ASSERT_EQ(net.fitnessValues.size(), 3);
+        for(size_t s=0; s+1<offsets.size(); s++){
+            Network reference = net;
+            reference.fitAccuracy(rows(s), labels(s), 10, 0);
+            EXPECT_FLOAT_EQ(net.fitnessValues[s], reference.fitness);
+        }
+        EXPECT_FLOAT_EQ(net.fitness, aggregateScores(net.fitnessValues, "worst"));
+        ASSERT_EQ(net.objectives.size(), 2);
+        EXPECT_FLOAT_EQ(net.objectives[0], aggregateScores(net.fitnessValues, "mean"));
+    }
+}
+
+TEST_F(MultiSeriesTest, BacktestRestartsFlatPerSeries) {
+    auto generator = std::make_shared<std::mt19937_64>(1);
+    Network net(generator, 0, 1, 3, 1, false); // only processing nodes with f = 0
+    std::vector<float> returns(offsets.back(), 0);
+    returns[0] = 0.01;
+    returns[80] = 0.02;
+    returns[130] = 0.03;
+    net.fitBacktestMultiSeries(X, returns, offsets, {1}, 10, -100, 0.001, "return");
+    ASSERT_EQ(net.fitnessValues.size(), 3);
+    EXPECT_NEAR(net.fitnessValues[0], 0.01 - 0.001, 1e-6); // entry cost paid in every series
+    EXPECT_NEAR(net.fitnessValues[1], 0.02 - 0.001, 1e-6);
+    EXPECT_NEAR(net.fitnessValues[2], 0.03 - 0.001, 1e-6);
+    EXPECT_NEAR(net.fitness, 0.02 - 0.001, 1e-6);
+}
+
+TEST_F(MultiSeriesTest, RejectsInvalidArguments) {
+    Population population = testdata::unitPopulation(2, 4, 3, 3, 2);
+    EXPECT_THROW(population.multiSeriesAccuracy(X, y, {0, 10}, 10), std::invalid_argument);
+    EXPECT_THROW(population.multiSeriesAccuracy(X, y, offsets, 10, "median"), std::invalid_argument);
+}
@@ -1,9 +1,11 @@
 #include <gtest/gtest.h>
+#include <limits>
 #include <memory>
 #include <random>
 #include <unordered_map>
 #include <vector>
 #include "../include/Network.hpp"
+#include "../include/Population.hpp"
 
 class NetworkRemapTest : public ::testing::Test {
 protected:
@@ -107,3 +109,86 @@ TEST_F(NetworkRemapTest, RemapNodeIdsAndEdges_EmptyMapping) {
     EXPECT_EQ(net.innerNodes[0].edges, originalEdges);
 }
 
+
+namespace {
+
+// native environment without Python: constant reward per step, episode ends after length steps
+struct CountingEnvironment {
+    int steps = 0;
+    float reward = 1;
+    int length = 5;
+
+    std::vector<double> resetObservation(int){
+        steps = 0;
+        return {0.5, 0.5};
+    }
+
+    EnvironmentStep stepAction(int){
+        steps ++;
+        return EnvironmentStep{{0.5, 0.5}, reward, steps >= length, false};
+    }
+};
+
+}
+
+TEST(EnvironmentTest, FitGymnasiumRunsNativeEnvironments) {
+    static_assert(Environment<CountingEnvironment>);
+    auto generator = std::make_shared<std::mt19937_64>(1);
+    Network net(generator, 0, 1, 3, 2, false); // only processing nodes
+    CountingEnvironment env;
+    net.fitGymnasium(env, 10, 100, 100, -1, 0);
+    EXPECT_FLOAT_EQ(net.fitness, 5);
+    EXPECT_EQ(net.behavior, (std::vector<float>{0.5, 0.5})); // final observation
+    net.fitGymnasium(env, 10, 3, 100, -1, 0);
+    EXPECT_FLOAT_EQ(net.fitness, 3); // maxSteps
+}
+
+TEST(EnvironmentTest, EpisodeBoundCutsHopelessEpisodes) {
+    auto generator = std::make_shared<std::mt19937_64>(1);
+    Network net(generator, 0, 1, 3, 2, false);
+    CountingEnvironment env;
+    env.reward = 0.5;
+    env.length = 100;
+
+    // after s steps at most 0.5*s + (20-s) is reachable, which drops below 15 at s = 11
+    EpisodeBound bound{15, 1};
+    net.fitGymnasium(env, 10, 20, 100, -1, 0, true, bound);
+    EXPECT_TRUE(net.truncated);
+    EXPECT_EQ(env.steps, 11);
+    EXPECT_FLOAT_EQ(net.fitness, 5.5 + 9); // best reachable return
+    EXPECT_LT(net.fitness, bound.threshold);
+    EXPECT_EQ(net.lastFitness, std::numeric_limits<float>::lowest());
+
+    // reachable threshold and inactive bound run the full episode
+    net.fitGymnasium(env, 10, 20, 100, -1, 0, true, EpisodeBound{5, 1});
+    EXPECT_FALSE(net.truncated);
+    EXPECT_FLOAT_EQ(net.fitness, 10);
+    net.fitGymnasium(env, 10, 20, 100, -1, 0);
+    EXPECT_FALSE(net.truncated);
+    EXPECT_FLOAT_EQ(net.fitness, 10);
+}
+
+TEST(EnvironmentTest, EpisodeBoundOnMultiSeedMean) {
+    Population population(2, 3, 0, 1, 3, 2, false);
+    CountingEnvironment env;
+    env.reward = 0.5;
+    env.length = 100;
+    std::vector<int> seeds = {0, 1, 2};
+
+    population.gymnasiumMultiSeed(env, 10, 10, 100, -1, seeds);
+    for(const auto& net : population.individuals){
+        EXPECT_FLOAT_EQ(net.fitness, 5);
+        EXPECT_EQ(net.fitnessValues.size(), 3);
+    }
+
+    // mean 5 of the three seeds is out of reach of a threshold of 8: the second seed needs
+    // 9 with 10 still reachable and is cut after 3 steps (1.5 + 7 reachable), the third is skipped
+    population.gymnasiumMultiSeed(env, 10, 10, 100, -1, seeds, EpisodeBound{8, 1});
+    for(const auto& net : population.individuals){
+        EXPECT_TRUE(net.truncated);
+        EXPECT_EQ(net.fitnessValues, (std::vector<float>{5, 8.5}));
+        EXPECT_EQ(net.lastStepRewards, (std::vector<float>{0.5, std::numeric_limits<float>::lowest()}));
+        EXPECT_FLOAT_EQ(net.fitness, (5 + 8.5 + 10) / 3); // skipped seed counts with its bound
+        EXPECT_LT(net.fitness, 8);
+    }
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "../include/Population.hpp"
 #include "../include/Network.hpp"
+#include "TestData.hpp"
 
 class AddOverhangNodesTest : public ::testing::Test {
 protected:
@@ -99,3 +100,25 @@ TEST_F(AddOverhangNodesTest, HandlesEmptySmallerSuccessor) {
     EXPECT_EQ(parent2.innerNodes.size(), initialParent2Size + successor1.size());
 }
 
+
+TEST(DecisionMatrixTest, RowsEqualTraversePathAndInvalidRowsAreMarked) {
+    std::vector<std::vector<float>> X = testdata::uniformRows(2, 40);
+    Population population = testdata::unitPopulation(6, 8, 4, 3, 3);
+    std::vector<int8_t> matrix(population.individuals.size() * X.size());
+    population.decisionMatrix(X, 2, matrix.data());
+    for(size_t i=0; i<population.individuals.size(); i++){
+        Network reference = population.individuals[i];
+        reference.traversePath(X, 2);
+        for(size_t r=0; r<X.size(); r++){
+            int8_t dec = matrix[i * X.size() + r];
+            if(dec == -1){
+                EXPECT_TRUE(population.individuals[i].invalid);
+                break;
+            }
+            EXPECT_EQ(dec, reference.decisions[r]);
+        }
+    }
+    population.assignFitness(std::vector<float>(population.individuals.size(), 0.5));
+    EXPECT_FLOAT_EQ(population.individuals[3].fitness, 0.5);
+    EXPECT_THROW(population.assignFitness({1}), std::invalid_argument);
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+#include "../include/AsyncEvaluation.hpp"
+#include "../include/PopulationView.hpp"
+#include "TestData.hpp"
+
+class PopulationViewTest : public ::testing::Test {
+protected:
+    std::vector<std::vector<float>> X;
+    std::vector<int> y;
+
+    void SetUp() override {
+        X = testdata::uniformRows(6, 80);
+        y = testdata::thresholdLabels(X, 1, 0.5);
+    }
+
+    Population makePopulation(){
+        return testdata::unitPopulation(2, 12, 2, 2, 2);
+    }
+};
+
+TEST_F(PopulationViewTest, EvaluatesInPlaceWithoutCopies) {
+    Population population = makePopulation();
+    population.accuracy(X, y, 10, 2);
+    std::vector<float> expected = {population.individuals[3].fitness, population.individuals[7].fitness};
+    for(auto& net : population.individuals){
+        net.fitness = -1;
+    }
+    const Node* firstNode = population.individuals[7].innerNodes.data();
+    {
+        PopulationView view(population, {7, 3});
+        ASSERT_EQ(view.population().individuals.size(), 2);
+        EXPECT_EQ(view.population().ni, 2);
+        // the node storage is moved, not copied
+        EXPECT_EQ(view.population().individuals[0].innerNodes.data(), firstNode);
+        EXPECT_THROW(PopulationView(population, {0}), std::runtime_error);
+        view.population().accuracy(X, y, 10, 2);
+    }
+    EXPECT_FALSE(population.borrowed);
+    EXPECT_EQ(population.individuals[7].innerNodes.data(), firstNode);
+    EXPECT_FLOAT_EQ(population.individuals[3].fitness, expected[0]);
+    EXPECT_FLOAT_EQ(population.individuals[7].fitness, expected[1]);
+    EXPECT_FLOAT_EQ(population.individuals[0].fitness, -1);
+}
+
+TEST_F(PopulationViewTest, MapsEliteAndBlocksParent) {
+    Population population = makePopulation();
+    population.accuracy(X, y, 10, 2);
+    population.tournamentSelection(2, 2);
+    int elite = population.indicesElite[1];
+
+    PopulationView view(population, {elite == 0 ? 1 : 0, elite});
+    EXPECT_EQ(view.population().indicesElite, std::vector<int>{1});
+    EXPECT_TRUE(population.borrowed);
+    EXPECT_THROW(evaluateAsync(population, [](Population&){}), std::runtime_error);
+    view.release();
+    EXPECT_FALSE(view.active());
+    EXPECT_THROW(view.population(), std::runtime_error);
+    view.release(); // no-op
+    EXPECT_EQ(population.individuals.size(), 12);
+}
+
+TEST_F(PopulationViewTest, ReleaseRejectsResizedParent) {
+    Population population = makePopulation();
+    PopulationView view(population, {2, 11});
+    population.individuals.erase(population.individuals.begin() + 8, population.individuals.end());
+    EXPECT_THROW(view.release(), std::runtime_error);
+    EXPECT_FALSE(view.active());
+    EXPECT_FALSE(population.borrowed);
+    EXPECT_EQ(population.individuals.size(), 8);
+
+    // the destructor drops the individuals instead of throwing
+    {
+        PopulationView scoped(population, {7});
+        population.individuals.pop_back();
+    }
+    EXPECT_FALSE(population.borrowed);
+    EXPECT_EQ(population.individuals.size(), 7);
+}
+
+TEST_F(PopulationViewTest, CopySubsetIsIndependent) {
+    Population population = makePopulation();
+    Population copy = population.copySubset({5, 1});
+    ASSERT_EQ(copy.individuals.size(), 2);
+    EXPECT_EQ(copy.individuals[0].innerNodes.size(), population.individuals[5].innerNodes.size());
+    copy.individuals[0].fitness = 42;
+    EXPECT_NE(population.individuals[5].fitness, 42);
+    EXPECT_THROW(population.copySubset({1, 1}), std::invalid_argument);
+    EXPECT_THROW(population.copySubset({12}), std::invalid_argument);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "../include/Population.hpp"
+#include "../include/SeedHistory.hpp"
+
+namespace {
+
+// one-step episodes whose reward is the seed
+struct SeedRewardEnvironment {
+    int seed = 0;
+
+    std::vector<double> resetObservation(int _seed){
+        seed = _seed;
+        return {0.5};
+    }
+
+    EnvironmentStep stepAction(int){
+        return EnvironmentStep{{0.5}, static_cast<float>(seed), true, false};
+    }
+};
+
+}
+
+TEST(SeedHistoryTest, RingBufferKeepsNewestReturns) {
+    SeedHistory history(3);
+    for(float v : {1, 2, 3, 4, 5}){
+        history.push(v);
+    }
+    EXPECT_EQ(history.size(), 3);
+    EXPECT_EQ(history.toVector(), (std::vector<float>{3, 4, 5}));
+
+    history.setCapacity(2);
+    EXPECT_EQ(history.toVector(), (std::vector<float>{4, 5}));
+    history.setCapacity(4);
+    history.push(6);
+    EXPECT_EQ(history.toVector(), (std::vector<float>{4, 5, 6}));
+
+    SeedHistory none;
+    none.push(1);
+    EXPECT_EQ(none.size(), 0);
+    EXPECT_EQ(none.aggregate("mean"), 0);
+}
+
+TEST(SeedHistoryTest, Aggregations) {
+    SeedHistory history(4);
+    for(float v : {10, -2, 4, 8}){
+        history.push(v);
+    }
+    EXPECT_FLOAT_EQ(history.aggregate("mean"), 5);
+    EXPECT_FLOAT_EQ(history.aggregate("worstk", 2), 1);
+    EXPECT_FLOAT_EQ(history.aggregate("worstk", 10), 5);
+    EXPECT_FLOAT_EQ(history.aggregate("quantile", 0), -2);
+    // chronological: 10 -> 4 -> 4 -> 6
+    EXPECT_FLOAT_EQ(history.aggregate("ema", 0.5), 6);
+    EXPECT_FLOAT_EQ(history.aggregate("ema", 1), 8);
+
+    EXPECT_THROW(checkSeedAggregation("median", 0.5), std::invalid_argument);
+    EXPECT_THROW(checkSeedAggregation("ema", 0), std::invalid_argument);
+    EXPECT_THROW(checkSeedAggregation("worstk", 0), std::invalid_argument);
+    EXPECT_THROW(checkSeedAggregation("quantile", 2), std::invalid_argument);
+}
+
+TEST(SeedHistoryTest, SeedPoolRollsOldestSeeds) {
+    SeedPool pool;
+    pool.anchors = {7};
+    pool.rolling = {1, 2, 3};
+    pool.maxSeed = 100;
+    std::mt19937_64 generator(4);
+    pool.roll(generator, 2);
+    std::vector<int> seeds = pool.seeds();
+    ASSERT_EQ(seeds.size(), 4);
+    EXPECT_EQ(seeds[0], 7);
+    EXPECT_EQ(seeds[1], 3);
+    for(size_t i=2; i<seeds.size(); i++){
+        EXPECT_GE(seeds[i], 0);
+        EXPECT_LE(seeds[i], 100);
+    }
+    pool.roll(generator, 10); // clamped to the rolling pool
+    EXPECT_EQ(pool.seeds().size(), 4);
+}
+
+TEST(SeedHistoryTest, PopulationAggregatesHistoryAcrossGenerations) {
+    Population population(1, 4, 0, 1, 2, 2, false);
+    SeedRewardEnvironment env;
+    EXPECT_THROW(population.gymnasiumSeedHistory(env, 10, 10, 100, -1, {1}), std::invalid_argument);
+
+    population.setSeedHistoryCapacity(4);
+    population.gymnasiumSeedHistory(env, 10, 10, 100, -1, {1, 3}, "mean");
+    for(const auto& net : population.individuals){
+        EXPECT_FLOAT_EQ(net.fitness, 2);
+    }
+    population.gymnasiumSeedHistory(env, 10, 10, 100, -1, {5, 7}, "mean");
+    for(const auto& net : population.individuals){
+        EXPECT_FLOAT_EQ(net.fitness, 4);
+    }
+    // the oldest returns (1, 3) are overwritten
+    population.gymnasiumSeedHistory(env, 10, 10, 100, -1, {9, 11}, "worstk", 1);
+    for(const auto& net : population.individuals){
+        EXPECT_FLOAT_EQ(net.fitness, 5);
+        EXPECT_EQ(net.seedHistory.toVector(), (std::vector<float>{5, 7, 9, 11}));
+    }
+
+    // selection copies the history to the offspring
+    population.tournamentSelection(2, 1);
+    for(const auto& net : population.individuals){
+        EXPECT_EQ(net.seedHistory.size(), 4);
+    }
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <vector>
+#include "../include/Population.hpp"
+#include "TestData.hpp"
+
+class StreamingAccuracyTest : public ::testing::Test {
+protected:
+    std::shared_ptr<std::mt19937_64> generator;
+    std::vector<std::vector<float>> X;
+    std::vector<int> y;
+    std::vector<float> minF = {0, 0};
+    std::vector<float> maxF = {1, 1};
+
+    void SetUp() override {
+        generator = std::make_shared<std::mt19937_64>(3);
+        X = testdata::uniformRows(*generator, 200);
+        y = testdata::thresholdLabels(X, 0, 0.5);
+    }
+
+    Network makeNetwork(){
+        Network net(generator, 3, 2, 3, 2, false);
+        for(auto& node : net.innerNodes){
+            if(node.type == "J"){
+                node.setEdgesBoundaries(minF[node.f], maxF[node.f]);
+            }
+        }
+        return net;
+    }
+
+    std::vector<std::vector<float>> rows(size_t begin, size_t end){
+        return std::vector<std::vector<float>>(X.begin()+begin, X.begin()+end);
+    }
+
+    std::vector<int> labels(size_t begin, size_t end){
+        return std::vector<int>(y.begin()+begin, y.begin()+end);
+    }
+};
+
+TEST_F(StreamingAccuracyTest, WindowExpiresOldestRows) {
+    StreamWindow window(50);
+    window.append(rows(0, 30), labels(0, 30));
+    window.append(rows(30, 80), labels(30, 80));
+    EXPECT_EQ(window.size(), 50);
+    EXPECT_EQ(window.firstRow(), 30);
+    EXPECT_EQ(window.endRow(), 80);
+    EXPECT_EQ(window.label(30), y[30]);
+}
+
+TEST_F(StreamingAccuracyTest, ReanchoringEqualsFullEvaluation) {
+    StreamWindow window(60);
+    for(int n=0; n<5; n++){
+        Network net = makeNetwork();
+        Network reference = net;
+        for(size_t end=40; end<=200; end+=40){
+            window = StreamWindow(60);
+            window.append(rows(0, end), labels(0, end));
+            net.fitStreamingAccuracy(window, 10, 0); // always from scratch
+            reference.fitAccuracy(rows(end-window.size(), end), labels(end-window.size(), end), 10, 1);
+            EXPECT_FLOAT_EQ(net.fitness, reference.fitness);
+        }
+    }
+}
+
+TEST_F(StreamingAccuracyTest, IncrementalUpdateOnlyEvaluatesNewRows) {
+    for(int n=0; n<5; n++){
+        StreamWindow window(60);
+        Network net = makeNetwork();
+        window.append(rows(0, 60), labels(0, 60));
+        net.fitStreamingAccuracy(window, 10, 1000);
+        if(net.invalid){
+            continue;
+        }
+        // reference: one uninterrupted traversal from the anchor row
+        Network reference = net;
+        std::vector<int> hits;
+        reference.currentNodeID = reference.startNode.edges[0];
+        reference.nConsecutiveP = 0;
+        for(size_t r=0; r<200; r++){
+            int dec = reference.decisionAndNextNode(X[r], 10);
+            hits.push_back(dec == y[r] ? 1 : 0);
+        }
+        for(size_t end=80; end<=200; end+=20){
+            window.append(rows(end-20, end), labels(end-20, end));
+            net.fitStreamingAccuracy(window, 10, 1000);
+            float correct = 0;
+            for(size_t r=end-60; r<end; r++){
+                correct += hits[r];
+            }
+            EXPECT_FLOAT_EQ(net.fitness, correct / 60);
+            EXPECT_EQ(net.streamState.contributions.size(), 60);
+            EXPECT_EQ(net.streamState.rowsSinceAnchor, end-60);
+        }
+    }
+}
+
+TEST_F(StreamingAccuracyTest, GeneticOperatorsInvalidateCheckpoint) {
+    Population population = testdata::unitPopulation(1, 6, 3, 3, 2);
+    StreamWindow window(50);
+    window.append(rows(0, 50), labels(0, 50));
+    population.streamingAccuracy(window, 10, 1000);
+    population.tournamentSelection(2, 1);
+    population.callEdgeMutation(0.5, 0.5);
+    for(size_t i=0; i<population.individuals.size(); i++){
+        bool elite = std::find(population.indicesElite.begin(), population.indicesElite.end(), i) != population.indicesElite.end();
+        if(!elite){
+            EXPECT_FALSE(population.individuals[i].streamState.valid);
+        }
+    }
+}
+
+TEST_F(StreamingAccuracyTest, NewWindowReanchors) {
+    for(int n=0; n<5; n++){
+        Network net = makeNetwork();
+        StreamWindow window(60);
+        window.append(rows(0, 100), labels(0, 100));
+        net.fitStreamingAccuracy(window, 10, 1000);
+        if(net.invalid){
+            continue;
+        }
+        // a reset window that ends before the checkpoint must not report the old rows
+        StreamWindow reset(60);
+        reset.append(rows(100, 150), labels(100, 150));
+        net.fitStreamingAccuracy(reset, 10, 1000);
+        if(net.invalid){
+            continue;
+        }
+        Network reference = makeNetwork();
+        reference.innerNodes = net.innerNodes;
+        reference.startNode = net.startNode;
+        reference.fitAccuracy(rows(100, 150), labels(100, 150), 10, 1);
+        EXPECT_FLOAT_EQ(net.fitness, reference.fitness);
+        EXPECT_EQ(net.streamState.contributions.size(), 50);
+        EXPECT_EQ(net.streamState.firstRow, 0);
+    }
+}
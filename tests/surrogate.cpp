@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+#include "../include/Surrogate.hpp"
+#include "TestData.hpp"
+
+class SurrogateTest : public ::testing::Test {
+protected:
+    std::vector<std::vector<float>> X;
+    std::vector<int> y;
+
+    void SetUp() override {
+        X = testdata::uniformRows(11, 80);
+        y = testdata::labels(X, [](const std::vector<float>& row){ return row[0] + row[1] > 1.0f; });
+    }
+
+    Population makePopulation(){
+        return testdata::unitPopulation(5, 20, 2, 2, 2);
+    }
+};
+
+TEST_F(SurrogateTest, PredictsNearestNeighbours) {
+    Surrogate surrogate(2, 3);
+    EXPECT_THROW(surrogate.predict({0, 0}), std::runtime_error);
+    surrogate.add({0, 0}, 1);
+    surrogate.add({10, 0}, 3);
+    surrogate.add({0, 10}, 100);
+    surrogate.fit();
+    EXPECT_FLOAT_EQ(surrogate.predict({10, 0}), 3);
+    // halfway between the two nearest samples
+    EXPECT_FLOAT_EQ(surrogate.predict({5, 0}), 2);
+    EXPECT_THROW(surrogate.add({1}, 0), std::invalid_argument);
+    // the oldest sample is replaced once the buffer is full
+    surrogate.add({10, 0}, 5);
+    surrogate.fit();
+    EXPECT_EQ(surrogate.size(), 3);
+    EXPECT_FLOAT_EQ(surrogate.predict({0, 0}), 4);
+}
+
+TEST_F(SurrogateTest, ScreensTopFractionAndElite) {
+    Population population = makePopulation();
+    Surrogate surrogate(3);
+    std::vector<std::vector<float>> probe(X.begin(), X.begin() + 8);
+
+    // without samples every individual is evaluated
+    std::vector<int> all = surrogate.screen(population, probe, 10, 0.25, -1);
+    EXPECT_EQ(all.size(), population.individuals.size());
+    population.accuracy(X, y, 10, 2);
+    surrogate.update(population, all);
+    EXPECT_EQ(surrogate.size(), population.individuals.size());
+
+    population.tournamentSelection(2, 2);
+    population.callEdgeMutation(0.1, 0.1);
+    std::vector<int> selected = surrogate.screen(population, probe, 10, 0.25, -1);
+    EXPECT_GE(selected.size(), 5);
+    EXPECT_LE(selected.size(), 7);
+    for(int e : population.indicesElite){
+        EXPECT_NE(std::find(selected.begin(), selected.end(), e), selected.end());
+    }
+    for(size_t i=0; i<population.individuals.size(); i++){
+        bool isSelected = std::find(selected.begin(), selected.end(), i) != selected.end();
+        if(!isSelected){
+            EXPECT_FLOAT_EQ(population.individuals[i].fitness, -1);
+        }
+    }
+    EXPECT_EQ(surrogate.screenedOut(), population.individuals.size() - selected.size());
+    EXPECT_THROW(surrogate.screen(population, probe, 10, 0, -1), std::invalid_argument);
+}
+
+TEST_F(SurrogateTest, EvaluatesSelectedIndividualsExactly) {
+    Population population = makePopulation();
+    Population reference = makePopulation();
+    Surrogate surrogate(3);
+    std::vector<std::vector<float>> probe(X.begin(), X.begin() + 8);
+    auto evaluate = [&](Population& p){ p.accuracy(X, y, 10, 2); };
+    for(int g=0; g<3; g++){
+        std::vector<int> selected = prescreenAndEvaluate(population, surrogate, probe, 10, 0.5, evaluate, 0);
+        EXPECT_FALSE(population.borrowed);
+        reference.individuals = population.individuals;
+        reference.accuracy(X, y, 10, 2);
+        for(int i : selected){
+            EXPECT_FLOAT_EQ(population.individuals[i].fitness, reference.individuals[i].fitness);
+        }
+        population.tournamentSelection(2, 1);
+        population.callEdgeMutation(0.1, 0.1);
+    }
+    EXPECT_GT(surrogate.screenedOut(), 0);
+}
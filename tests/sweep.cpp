@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+#include "../include/Sweep.hpp"
+#include "TestData.hpp"
+
+class SweepTest : public ::testing::Test {
+protected:
+    std::vector<std::vector<float>> X;
+    std::vector<int> y;
+    std::vector<float> minF = {0, 0};
+    std::vector<float> maxF = {1, 1};
+    std::function<void(Population&)> evaluate;
+
+    void SetUp() override {
+        X = testdata::uniformRows(9, 60);
+        y = testdata::thresholdLabels(X, 0, 0.4f);
+        evaluate = [this](Population& p){ p.accuracy(X, y, 10, 2); };
+    }
+
+    std::vector<SweepConfig> makeConfigs(size_t n){
+        std::vector<SweepConfig> configs(n);
+        for(size_t c=0; c<n; c++){
+            configs[c].name = "c" + std::to_string(c);
+            configs[c].seed = 100 + c;
+            configs[c].ni = 10;
+            configs[c].jn = 1 + c % 3;
+            configs[c].tournamentSize = 2 + c % 2;
+        }
+        return configs;
+    }
+};
+
+TEST_F(SweepTest, SuccessiveHalvingAbandonsConfigurations) {
+    SweepOptions options;
+    options.generations = 8;
+    options.rungGenerations = 2;
+    options.eta = 2;
+    options.nThreads = 3;
+    std::vector<SweepResult> results = runSweep(makeConfigs(8), evaluate, minF, maxF, options);
+    ASSERT_EQ(results.size(), 8);
+    // rungs of 2, 4 and 8 generations keep 8 -> 4 -> 2 -> 1 configurations
+    int survivors = 0;
+    for(size_t c=0; c<results.size(); c++){
+        const SweepResult& result = results[c];
+        EXPECT_EQ(result.config, c);
+        EXPECT_EQ(result.name, "c" + std::to_string(c));
+        EXPECT_EQ(result.bestPerGeneration.size(), result.generations);
+        EXPECT_EQ(result.meanPerGeneration.size(), result.generations);
+        ASSERT_NE(result.best, nullptr);
+        if(result.abandoned){
+            EXPECT_LT(result.generations, 8);
+        } else {
+            EXPECT_EQ(result.generations, 8);
+            survivors++;
+        }
+    }
+    EXPECT_EQ(survivors, 2);
+}
+
+TEST_F(SweepTest, MatchesSerialEvolution) {
+    std::vector<SweepConfig> configs = makeConfigs(3);
+    SweepOptions options;
+    options.generations = 5;
+    options.rungGenerations = 5; // no halving
+    options.nThreads = 2;
+    std::vector<SweepResult> results = runSweep(configs, evaluate, minF, maxF, options);
+
+    Population population(configs[1].seed, configs[1].ni, configs[1].jn, 2, configs[1].pn, configs[1].pnf, false);
+    population.nThreads = 1;
+    population.setAllNodeBoundaries(minF, maxF);
+    for(int g=0; g<5; g++){
+        evolveGeneration(population, configs[1], evaluate, minF, maxF);
+        EXPECT_FLOAT_EQ(results[1].bestPerGeneration[g], population.bestFit);
+        EXPECT_FLOAT_EQ(results[1].meanPerGeneration[g], population.meanFitness);
+    }
+    for(const SweepResult& result : results){
+        EXPECT_FALSE(result.abandoned);
+        EXPECT_EQ(result.generations, 5);
+    }
+}
+
+TEST_F(SweepTest, RejectsInvalidSchedules) {
+    SweepOptions options;
+    EXPECT_THROW(runSweep({}, evaluate, minF, maxF, options), std::invalid_argument);
+    options.eta = 1;
+    EXPECT_THROW(runSweep(makeConfigs(2), evaluate, minF, maxF, options), std::invalid_argument);
+    options.eta = 2;
+    EXPECT_THROW(runSweep(makeConfigs(2), evaluate, minF, {1}, options), std::invalid_argument);
+}
@@ -0,0 +1,33 @@
+import fracnetics as fn
+import numpy as np
+
+def test_bulk_accessors():
+    pop = fn.Population(
+        seed=42,
+        ni=10,
+        jn=3,
+        jnf=2,
+        pn=2,
+        pnf=2,
+        fractalJudgment=False,
+        nFeatureValues=[]
+    )
+    pop.setAllNodeBoundaries([0, 0], [1, 1])
+    rng = np.random.default_rng(0)
+    X = rng.random((100, 2), dtype=np.float32)
+    y = (X[:, 0] > 0.5).astype(np.int32)
+    pop.accuracy(X, y, dMax=10, penalty=2)
+
+    fitness = pop.fitnessArray()
+    assert fitness.shape == (10,)
+    assert np.allclose(fitness, [ind.fitness for ind in pop.individuals])
+    assert list(pop.invalidArray()) == [ind.invalid for ind in pop.individuals]
+    assert list(pop.networkSizeArray()) == [len(ind.innerNodes) for ind in pop.individuals]
+    assert (pop.usedNodesArray() <= pop.networkSizeArray()).all()
+    assert (pop.crossoverArray() == 0).all()
+    assert pop.objectivesArray().shape == (10, 0)
+
+    pop.multiSeriesAccuracy(X, y, offsets=[0, 40, 100], dMax=10)
+    objectives = pop.objectivesArray()
+    assert objectives.shape == (10, 2)
+    assert np.allclose(objectives[:, 0], [np.mean(ind.fitnessValues) for ind in pop.individuals])
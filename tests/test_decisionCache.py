@@ -0,0 +1,23 @@
+import fracnetics as fn
+import numpy as np
+
+def test_assigning_nodes_rebuilds_the_decision_cache():
+    pop = fn.Population(seed=2, ni=4, jn=3, jnf=2, pn=2, pnf=2, fractalJudgment=False, nFeatureValues=[])
+    pop.setAllNodeBoundaries([0, 0], [1, 1])
+    X = np.random.default_rng(3).random((50, 2), dtype=np.float32)
+    net = pop.individuals[0]
+    net.setDecisionCache(64)
+    net.traversePath(X, 10)
+    assert net.decisionCacheStats.rebuilds == 1
+
+    # the setters invalidate the cache; in-place edits need genomeChanged()
+    net.innerNodes = net.innerNodes
+    net.traversePath(X, 10)
+    assert net.decisionCacheStats.rebuilds == 2
+    net.startNode = net.startNode
+    net.traversePath(X, 10)
+    assert net.decisionCacheStats.rebuilds == 3
+    net.startNode.edges = net.startNode.edges
+    net.genomeChanged()
+    net.traversePath(X, 10)
+    assert net.decisionCacheStats.rebuilds == 4
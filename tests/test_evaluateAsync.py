@@ -0,0 +1,60 @@
+import asyncio
+import fracnetics as fn
+import numpy as np
+import pytest
+
+def make_data():
+    rng = np.random.default_rng(4)
+    X = rng.random((500, 2), dtype=np.float32)
+    y = (X[:, 0] > 0.5).astype(np.float32)
+    return X, y
+
+def make_population():
+    pop = fn.Population(seed=1, ni=20, jn=4, jnf=2, pn=2, pnf=2, fractalJudgment=False, nFeatureValues=[])
+    pop.setAllNodeBoundaries([0, 0], [1, 1])
+    return pop
+
+def test_wait_commits_results_and_conflicting_calls_are_rejected():
+    X, y = make_data()
+    pop = make_population()
+    reference = make_population()
+    handle = pop.evaluateAsync("accuracy", X, y, dMax=10)
+    with pytest.raises(RuntimeError):
+        pop.fitnessArray()
+    handle.wait()
+    assert handle.done()
+    reference.accuracy(X, y.astype(np.int32), dMax=10, penalty=2)
+    assert np.allclose(pop.fitnessArray(), reference.fitnessArray())
+
+def test_conflicting_call_raises_while_the_evaluation_runs():
+    rng = np.random.default_rng(5)
+    X = rng.random((200000, 2), dtype=np.float32)
+    y = (X[:, 0] > 0.5).astype(np.float32)
+    pop = fn.Population(seed=1, ni=200, jn=8, jnf=2, pn=4, pnf=2, fractalJudgment=False, nFeatureValues=[])
+    pop.setAllNodeBoundaries([0, 0], [1, 1])
+    pop.nThreads = 1
+    handle = pop.evaluateAsync("accuracy", X, y, dMax=10)
+    with pytest.raises(RuntimeError):
+        pop.fitnessArray()
+    # the call raised before the evaluation finished instead of waiting for it
+    assert not handle.done()
+    # budget and seedPool are guarded as well (their getters return copies)
+    with pytest.raises(RuntimeError):
+        pop.seedPool
+    with pytest.raises(RuntimeError):
+        pop.budget
+    handle.wait()
+    pool = pop.seedPool
+    pool.rolling = [7, 8]
+    assert pop.seedPool.rolling == []
+    pop.seedPool = pool
+    assert pop.seedPool.seeds() == [7, 8]
+
+def test_handle_is_awaitable():
+    X, y = make_data()
+    pop = make_population()
+    async def run():
+        handle = pop.evaluateAsync("balancedAccuracy", X, y, dMax=10)
+        await handle
+    asyncio.run(run())
+    assert pop.fitnessArray().shape == (20,)
@@ -0,0 +1,65 @@
+import fracnetics as fn
+import numpy as np
+import pytest
+
+def test_evaluate_decisions():
+    pop = fn.Population(
+        seed=42,
+        ni=10,
+        jn=3,
+        jnf=2,
+        pn=2,
+        pnf=2,
+        fractalJudgment=False,
+        nFeatureValues=[]
+    )
+    pop.setAllNodeBoundaries([0, 0], [1, 1])
+    rng = np.random.default_rng(0)
+    X = rng.random((100, 2), dtype=np.float32)
+    y = (X[:, 0] > 0.5).astype(np.int8)
+
+    calls = []
+    def accuracy(decisions):
+        calls.append(decisions.shape)
+        assert decisions.dtype == np.int8
+        return (decisions == y).mean(axis=1)
+
+    pop.evaluateDecisions(X, accuracy, dMax=10)
+    assert calls == [(10, 100)]
+
+    reference = fn.Population(seed=42, ni=10, jn=3, jnf=2, pn=2, pnf=2, fractalJudgment=False, nFeatureValues=[])
+    reference.setAllNodeBoundaries([0, 0], [1, 1])
+    reference.accuracy(X, y.astype(np.int32), dMax=10, penalty=2)
+    valid = ~pop.invalidArray()
+    assert np.allclose(pop.fitnessArray()[valid], reference.fitnessArray()[valid])
+
+def test_fitness_fn_may_use_the_population():
+    pop = fn.Population(seed=7, ni=8, jn=3, jnf=2, pn=2, pnf=2, fractalJudgment=False, nFeatureValues=[])
+    pop.setAllNodeBoundaries([0, 0], [1, 1])
+    rng = np.random.default_rng(1)
+    X = rng.random((50, 2), dtype=np.float32)
+    y = (X[:, 1] > 0.5).astype(np.int8)
+
+    returned = []
+    def fitness(decisions):
+        # the population is not locked while the callback runs
+        assert pop.fitnessArray().shape == (8,)
+        assert len(pop.individuals) == 8
+        assert pop.pnf == 2
+        returned.append((decisions == y).mean(axis=1).astype(np.float32))
+        return returned[-1]
+
+    pop.evaluateDecisions(X, fitness, dMax=10)
+    assert np.array_equal(pop.fitnessArray(), returned[0])
+
+def test_fitness_fn_changing_the_population_size_is_rejected():
+    pop = fn.Population(seed=7, ni=8, jn=3, jnf=2, pn=2, pnf=2, fractalJudgment=False, nFeatureValues=[])
+    pop.setAllNodeBoundaries([0, 0], [1, 1])
+    X = np.random.default_rng(2).random((20, 2), dtype=np.float32)
+
+    def fitness(decisions):
+        pop.individuals = list(pop.individuals)[:4]
+        return np.zeros(decisions.shape[0], dtype=np.float32)
+
+    with pytest.raises(ValueError):
+        pop.evaluateDecisions(X, fitness, dMax=10)
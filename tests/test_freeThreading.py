@@ -0,0 +1,68 @@
+import fracnetics as fn
+import numpy as np
+import sys
+import sysconfig
+import threading
+
+def make_population(seed):
+    pop = fn.Population(seed=seed, ni=20, jn=4, jnf=2, pn=2, pnf=2, fractalJudgment=False, nFeatureValues=[])
+    pop.setAllNodeBoundaries([0, 0], [1, 1])
+    pop.nThreads = 1
+    return pop
+
+def evolve(pop, X, y, generations):
+    for _ in range(generations):
+        pop.accuracy(X, y, dMax=10, penalty=2)
+        pop.tournamentSelection(2, 1)
+        pop.callEdgeMutation(0.1, 0.1)
+        pop.callBoundaryMutationNormal(0.1, 0.05)
+    pop.accuracy(X, y, dMax=10, penalty=2)
+    return pop.fitnessArray()
+
+def run_threads(targets):
+    errors = []
+    def wrap(target):
+        try:
+            target()
+        except Exception as e:
+            errors.append(e)
+    threads = [threading.Thread(target=wrap, args=(t,)) for t in targets]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    assert errors == []
+
+def test_module_keeps_gil_disabled_on_free_threaded_builds():
+    # importing an extension that is not declared free-threading compatible re-enables the GIL
+    if sysconfig.get_config_var("Py_GIL_DISABLED"):
+        assert not sys._is_gil_enabled()
+
+def test_independent_populations_in_threads_match_serial_runs():
+    rng = np.random.default_rng(1)
+    X = rng.random((200, 2), dtype=np.float32)
+    y = (X[:, 0] > 0.5).astype(np.int32)
+    seeds = range(8)
+    serial = [evolve(make_population(s), X, y, 5) for s in seeds]
+    results = {}
+    def job(s):
+        return lambda: results.__setitem__(s, evolve(make_population(s), X, y, 5))
+    run_threads([job(s) for s in seeds])
+    for s in seeds:
+        assert np.array_equal(results[s], serial[s])
+
+def test_shared_population_calls_are_serialised():
+    rng = np.random.default_rng(2)
+    X = rng.random((100, 2), dtype=np.float32)
+    y = (X[:, 1] > 0.5).astype(np.int32)
+    pop = make_population(3)
+    def hammer():
+        for _ in range(20):
+            pop.accuracy(X, y, dMax=10, penalty=2)
+            pop.callEdgeMutation(0.2, 0.2)
+            pop.classificationMetric(X, y, dMax=10, metric="kappa")
+            assert pop.fitnessArray().shape == (20,)
+    run_threads([hammer for _ in range(8)])
+    pop.accuracy(X, y, dMax=10, penalty=2)
+    fitness = pop.fitnessArray()
+    assert ((fitness >= 0) & (fitness <= 1)).all()
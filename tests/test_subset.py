@@ -0,0 +1,50 @@
+import fracnetics as fn
+import numpy as np
+import pytest
+
+def make_population():
+    pop = fn.Population(
+        seed=3,
+        ni=12,
+        jn=2,
+        jnf=2,
+        pn=2,
+        pnf=2,
+        fractalJudgment=False,
+        nFeatureValues=[]
+    )
+    pop.setAllNodeBoundaries([0, 0], [1, 1])
+    return pop
+
+def test_subset_shares_individuals():
+    pop = make_population()
+    rng = np.random.default_rng(1)
+    X = rng.random((80, 2), dtype=np.float32)
+    y = (X[:, 1] > 0.5).astype(np.int32)
+    reference = make_population()  # same seed, same genomes
+    reference.accuracy(X, y, dMax=10, penalty=2)
+    expected = reference.fitnessArray()[[4, 9]]
+
+    with pop.subset([4, 9]) as elite:
+        assert len(elite.individuals) == 2
+        with pytest.raises(RuntimeError):
+            pop.fitnessArray()  # parent is blocked while the view is active
+        with pytest.raises(RuntimeError):
+            pop.individuals
+        with pytest.raises(RuntimeError):
+            pop.individuals = []
+        elite.accuracy(X, y, dMax=10, penalty=2)
+
+    # the results are written into the parent slots
+    fitness = pop.fitnessArray()
+    assert np.allclose(fitness[[4, 9]], expected)
+    assert (fitness[[0, 1, 2]] < -1e30).all()  # not evaluated
+
+def test_copy_subset_is_independent():
+    pop = make_population()
+    copy = pop.copySubset([0, 5])
+    assert len(copy.individuals) == 2
+    copy.individuals[0].fitness = 123
+    assert pop.individuals[0].fitness != 123
+    with pytest.raises(ValueError):
+        pop.copySubset([0, 0])